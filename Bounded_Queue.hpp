@@ -0,0 +1,59 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Bounded_Queue Class: Blocking queue with a fixed capacity for handing work between threads
+ */
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+namespace hydrogen_framework {
+/**
+ * Bounded_Queue Class: First in first out queue where push waits while full and pop waits while empty
+ */
+template <typename T> class Bounded_Queue {
+public:
+  /**
+   * Constructor
+   * Capacity is at least one
+   */
+  Bounded_Queue(size_t capacity) : queueCapacity(capacity ? capacity : 1) {}
+
+  /**
+   * Destructor
+   */
+  ~Bounded_Queue() { queueItems.clear(); }
+
+  /**
+   * Push item to the back of queueItems. Waits till there is space for it
+   */
+  void push(T item) {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueNotFull.wait(lock, [this]() { return queueItems.size() < queueCapacity; });
+    queueItems.push_back(item);
+    queueNotEmpty.notify_one();
+  }
+
+  /**
+   * Pop item from the front of queueItems. Waits till there is one
+   */
+  T pop() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    queueNotEmpty.wait(lock, [this]() { return !queueItems.empty(); });
+    T item = queueItems.front();
+    queueItems.pop_front();
+    queueNotFull.notify_one();
+    return item;
+  }
+
+private:
+  size_t queueCapacity;                  /**< Maximum number of items in the queue */
+  std::deque<T> queueItems;              /**< Container for queued items */
+  std::mutex queueMutex;                 /**< Guards queueItems */
+  std::condition_variable queueNotFull;  /**< Signalled when an item is popped */
+  std::condition_variable queueNotEmpty; /**< Signalled when an item is pushed */
+};                                       // End Bounded_Queue Class
+} // namespace hydrogen_framework
+#endif
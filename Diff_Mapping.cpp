@@ -4,39 +4,67 @@
  * Implementing Diff_Mapping.hpp
  */
 #include "Diff_Mapping.hpp"
+#include <algorithm>
+#include <limits>
 namespace hydrogen_framework {
-void Diff_Mapping::putMapping(std::vector<sesElem> seqVector) {
-  for (auto iter : seqVector) {
-    elemInfo info;
-    switch (iter.second.type) {
-    case SES_ADD:
-      info.beforeIdx = iter.second.beforeIdx;
-      info.afterIdx = iter.second.afterIdx;
-      info.type = SES_ADD;
-      addedLines.push_back(iter.second.afterIdx);
-      break;
-    case SES_DELETE:
-      info.beforeIdx = iter.second.beforeIdx;
-      info.afterIdx = iter.second.afterIdx;
-      info.type = SES_DELETE;
-      deletedLines.push_back(iter.second.beforeIdx);
-      break;
-    case SES_COMMON:
-      info.beforeIdx = iter.second.beforeIdx;
-      info.afterIdx = iter.second.afterIdx;
-      info.type = SES_COMMON;
-      matchedLines.insert(std::pair<long long, long long>(iter.second.beforeIdx, iter.second.afterIdx));
-      break;
-    }
-    lineMap.push_back(info);
+void Diff_Mapping::putMapping(const std::vector<sesElem> &seqVector) {
+  /* Next line number of either file, for the side that added and deleted lines do not take */
+  long long beforeNext = 1, afterNext = 1;
+  for (const auto &iter : seqVector) {
+    long long beforeIdx = iter.type == SES_ADD ? beforeNext : iter.beforeIdx;
+    long long afterIdx = iter.type == SES_DELETE ? afterNext : iter.afterIdx;
+    if (!hunks.empty() && hunks.back().type == iter.type) {
+      ++hunks.back().length;
+    } else {
+      diffHunk hunk;
+      hunk.beforeStart = beforeIdx;
+      hunk.afterStart = afterIdx;
+      hunk.length = 1;
+      hunk.type = iter.type;
+      hunks.push_back(hunk);
+    } // End check for same type as the last hunk
+    beforeNext = iter.type == SES_ADD ? beforeIdx : beforeIdx + 1;
+    afterNext = iter.type == SES_DELETE ? afterIdx : afterIdx + 1;
   } // End loop for seqVector
 } // End putMapping
 
+std::vector<long long> Diff_Mapping::getLinesOfType(int type, bool before) const {
+  std::vector<long long> lines;
+  for (const auto &hunk : hunks) {
+    if (hunk.type == type) {
+      long long start = before ? hunk.beforeStart : hunk.afterStart;
+      for (long long line = start; line < start + hunk.length; ++line) {
+        lines.push_back(line);
+      } // End loop for line
+    }   // End check for type
+  }     // End loop for hunks
+  return lines;
+} // End getLinesOfType
+
+std::vector<long long> Diff_Mapping::getAddedLines() const { return getLinesOfType(SES_ADD, false); }
+
+std::vector<long long> Diff_Mapping::getDeletedLines() const { return getLinesOfType(SES_DELETE, true); }
+
+std::vector<std::pair<long long, long long>> Diff_Mapping::getMatchedLines() const {
+  std::vector<std::pair<long long, long long>> lines;
+  for (const auto &hunk : hunks) {
+    if (hunk.type == SES_COMMON) {
+      for (long long offset = 0; offset < hunk.length; ++offset) {
+        lines.push_back(std::make_pair(hunk.beforeStart + offset, hunk.afterStart + offset));
+      } // End loop for offset
+    }   // End check for SES_COMMON
+  }     // End loop for hunks
+  return lines;
+} // End getMatchedLines
+
 void Diff_Mapping::printMapping() {
   std::cout << "File name : " << fileName << "\n";
-  for (auto iter : lineMap) {
+  if (identical) {
+    std::cout << "Identical\n";
+  } // End check for identical
+  for (const auto &hunk : hunks) {
     std::string type;
-    switch (iter.type) {
+    switch (hunk.type) {
     case SES_ADD:
       type = "+";
       break;
@@ -45,25 +73,29 @@ void Diff_Mapping::printMapping() {
       break;
     case SES_COMMON:
       type = " ";
-    } // End switch for iter.type
-    std::cout << iter.beforeIdx << ":" << iter.afterIdx << "\t" << type << "\n";
-  } // End loop for lineMap
+    } // End switch for hunk.type
+    for (long long offset = 0; offset < hunk.length; ++offset) {
+      long long beforeIdx = hunk.type == SES_ADD ? 0 : hunk.beforeStart + offset;
+      long long afterIdx = hunk.type == SES_DELETE ? 0 : hunk.afterStart + offset;
+      std::cout << beforeIdx << ":" << afterIdx << "\t" << type << "\n";
+    } // End loop for offset
+  }   // End loop for hunks
 } // End printMapping
 
 void Diff_Mapping::printAddedLines() {
-  for (auto iter : addedLines) {
+  for (auto iter : getAddedLines()) {
     std::cout << SES_MARK_ADD << " " << iter << "\n";
   } // End loop for addedLines
 } // End printAddedLines
 
 void Diff_Mapping::printDeletedLines() {
-  for (auto iter : deletedLines) {
+  for (auto iter : getDeletedLines()) {
     std::cout << SES_MARK_DELETE << " " << iter << "\n";
   } // End loop for deletedLines
 } // End printDeletedLines
 
 void Diff_Mapping::printMatchedLines() {
-  for (auto iter : matchedLines) {
+  for (auto iter : getMatchedLines()) {
     std::cout << iter.first << ":" << iter.second << "\n";
   } // End loop for matchedLines
 } // End printMatchedLines
@@ -76,21 +108,37 @@ void Diff_Mapping::printFileInfo() {
   std::cout << "----\n";
 } // End printFileInfo
 
-long long Diff_Mapping::getAfterLineNumber(long long currLine) {
-  for (auto iter : lineMap) {
-    if (iter.beforeIdx == currLine) {
-      return iter.afterIdx;
-    } // End check for currLine
-  }   // End loop for lineMap
-  return std::numeric_limits<unsigned>::max();
-} // End getNewLineNumber
+long long Diff_Mapping::getAfterLineNumber(long long currLine) const {
+  if (identical) {
+    return currLine;
+  } // End check for identical
+  /* Last hunk starting at or before currLine. Hunks after an added hunk start at the same line */
+  auto hunk = std::upper_bound(hunks.begin(), hunks.end(), currLine,
+                               [](long long line, const diffHunk &h) -> bool { return line < h.beforeStart; });
+  if (hunk == hunks.begin()) {
+    return std::numeric_limits<unsigned>::max();
+  } // End check for first hunk
+  --hunk;
+  if (hunk->type == SES_ADD || currLine >= hunk->beforeStart + hunk->length) {
+    return std::numeric_limits<unsigned>::max();
+  } // End check for currLine in hunk
+  return hunk->type == SES_DELETE ? 0 : hunk->afterStart + (currLine - hunk->beforeStart);
+} // End getAfterLineNumber
 
-long long Diff_Mapping::getBeforeLineNumber(long long currLine) {
-  for (auto iter : lineMap) {
-    if (iter.afterIdx == currLine) {
-      return iter.beforeIdx;
-    } // End check for currLine
-  }   // End loop for lineMap
-  return std::numeric_limits<unsigned>::max();
-} // End getOldLineNumber
+long long Diff_Mapping::getBeforeLineNumber(long long currLine) const {
+  if (identical) {
+    return currLine;
+  } // End check for identical
+  /* Last hunk starting at or before currLine. Hunks after a deleted hunk start at the same line */
+  auto hunk = std::upper_bound(hunks.begin(), hunks.end(), currLine,
+                               [](long long line, const diffHunk &h) -> bool { return line < h.afterStart; });
+  if (hunk == hunks.begin()) {
+    return std::numeric_limits<unsigned>::max();
+  } // End check for first hunk
+  --hunk;
+  if (hunk->type == SES_DELETE || currLine >= hunk->afterStart + hunk->length) {
+    return std::numeric_limits<unsigned>::max();
+  } // End check for currLine in hunk
+  return hunk->type == SES_ADD ? 0 : hunk->beforeStart + (currLine - hunk->afterStart);
+} // End getBeforeLineNumber
 } // namespace hydrogen_framework
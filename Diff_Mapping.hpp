@@ -14,51 +14,83 @@
 namespace hydrogen_framework {
 /**
  * Diff_Mapping Class: Container for storing diff mapping details
+ * The mapping is kept as runs of consecutive lines with the same type of edit, in the order of the file
+ * Added, deleted and matched lines are derived from the runs
  */
 class Diff_Mapping : public Diff_Vars {
 public:
+  /**
+   * Run of consecutive lines with the same type of edit
+   * Added lines take no lines of the before file and deleted lines none of the after file, so their start on that
+   * side is where the next line of that file would be
+   */
+  typedef struct diffhunk {
+    long long beforeStart; /**< First line number in the before file */
+    long long afterStart;  /**< First line number in the after file */
+    long long length;      /**< Number of lines */
+    int type;              /**< Type of edit(Add, Delete, Common) */
+  } diffHunk;
+
   /**
    * Constructor
    */
-  Diff_Mapping(std::string name) : fileName(name) {}
+  Diff_Mapping(std::string name) : fileName(name), identical(false) {}
 
   /**
    * Destructor
    */
-  ~Diff_Mapping() { lineMap.clear(); }
+  ~Diff_Mapping() { hunks.clear(); }
 
   /**
    * Populate line mapping
    */
-  void putMapping(std::vector<sesElem> seqVector);
+  void putMapping(const std::vector<sesElem> &seqVector);
+
+  /**
+   * Mark the file as having the same contents in both versions
+   * Every line maps to itself and no line mapping is stored
+   */
+  void putIdentity() { identical = true; }
 
   /**
-   * Return lineMap
+   * Return identical
    */
-  std::list<elemInfo> getMapping() { return lineMap; }
+  bool isIdentical() const { return identical; }
+
+  /**
+   * Return hunks
+   * Empty for identical files
+   */
+  const std::vector<diffHunk> &getHunks() const { return hunks; }
 
   /**
    * Return fileName
    */
-  std::string getFileName() { return fileName; }
+  const std::string &getFileName() const { return fileName; }
+
+  /**
+   * Return the added line numbers of the after file in ascending order
+   */
+  std::vector<long long> getAddedLines() const;
 
   /**
-   * Return addedLines
+   * Return the deleted line numbers of the before file in ascending order
    */
-  std::list<long long> getAddedLines() { return addedLines; }
+  std::vector<long long> getDeletedLines() const;
 
   /**
-   * Return deletedLines
+   * Return the matched line numbers as pairs of before and after line numbers in ascending order
+   * Empty for identical files, where every line matches itself
    */
-  std::list<long long> getDeletedLines() { return deletedLines; }
+  std::vector<std::pair<long long, long long>> getMatchedLines() const;
 
   /**
-   * Return matchedLines
+   * Return TRUE if currLine of the after file was added
    */
-  std::map<long long, long long> getMatchedLines() { return matchedLines; }
+  bool isAddedLine(long long currLine) const { return getBeforeLineNumber(currLine) == 0; }
 
   /**
-   * Print lineMap
+   * Print line mapping
    */
   void printMapping();
 
@@ -84,23 +116,25 @@ public:
 
   /**
    * Get the afterIdx line number given the beforeIdx line number
-   * Return unsigned MAX if line not found
+   * Return 0 for deleted lines and unsigned MAX if line not found. Return currLine for identical files
    */
-  long long getAfterLineNumber(long long currLine);
+  long long getAfterLineNumber(long long currLine) const;
 
   /**
    * Get the beforeIdx line number given the afterIdx line number
-   * Return unsigned MAX if line not found
+   * Return 0 for added lines and unsigned MAX if line not found. Return currLine for identical files
    */
-  long long getBeforeLineNumber(long long currLine);
+  long long getBeforeLineNumber(long long currLine) const;
 
 private:
-  std::string fileName;              /**< File Name */
-  std::list<elemInfo> lineMap;       /**< Container for line mapping */
-  std::list<long long> addedLines;   /**< Container for added line numbers */
-  std::list<long long> deletedLines; /**< Container for deleted line numbers */
-  std::map<long long, long long>
-      matchedLines; /**< Container for matched line numbers mapping from before to after lines*/
-};                  // End Diff_Mapping Class
+  std::string fileName;        /**< File Name */
+  std::vector<diffHunk> hunks; /**< Runs of the line mapping in the order of the file */
+  bool identical;              /**< Flag for files with the same contents in both versions */
+
+  /**
+   * Return the line numbers of every hunk of the given type, taken from the before or the after file
+   */
+  std::vector<long long> getLinesOfType(int type, bool before) const;
+}; // End Diff_Mapping Class
 } // namespace hydrogen_framework
 #endif
@@ -4,13 +4,14 @@
  * Implementing Diff_Util.hpp
  */
 #include "Diff_Util.hpp"
+#include <algorithm>
+#include <unordered_map>
 namespace hydrogen_framework {
-void Diff_Ses::addSequence(elem e, long long beforeIdx, long long afterIdx, const int type) {
-  elemInfo info;
-  info.beforeIdx = beforeIdx;
-  info.afterIdx = afterIdx;
-  info.type = type;
-  sesElem pe(e, info);
+void Diff_Ses::addSequence(long long beforeIdx, long long afterIdx, const int type) {
+  sesElem pe;
+  pe.beforeIdx = beforeIdx;
+  pe.afterIdx = afterIdx;
+  pe.type = type;
   if (!deletesFirst) {
     sequenceDS.push_back(pe);
   } // End check for deletesFirst
@@ -41,14 +42,118 @@ void Diff_Ses::addSequence(elem e, long long beforeIdx, long long afterIdx, cons
   } // End switch for SES_DELETE
 } // End addSequence
 
-void Diff_Util::compose() {
-  pathCordinates.reserve(MAX_CORDINATES_SIZE);
+void Diff_Util::compose() { composeTrimmed(0, AIDs.size(), 0, BIDs.size()); } // End compose
+
+void Diff_Util::composeTrimmed(long long aLo, long long aHi, long long bLo, long long bHi) {
+  /* Common prefix */
+  while (aLo < aHi && bLo < bHi && isSameElem(aLo, bLo)) {
+    recordEdit(SES_COMMON, aLo, bLo);
+    ++aLo;
+    ++bLo;
+  } // End loop for common prefix
+  /* Common suffix is recorded after the rest of the window */
+  long long suffix = 0;
+  while (aLo < aHi - suffix && bLo < bHi - suffix && isSameElem(aHi - 1 - suffix, bHi - 1 - suffix)) {
+    ++suffix;
+  } // End loop for common suffix
+  aHi -= suffix;
+  bHi -= suffix;
+  if (anchored) {
+    composeAnchored(aLo, aHi, bLo, bHi);
+  } else {
+    composeWindow(aLo, aHi, bLo, bHi);
+  } // End check for anchored
+  for (long long common = 0; common < suffix; ++common) {
+    recordEdit(SES_COMMON, aHi + common, bHi + common);
+  } // End loop for common suffix
+} // End composeTrimmed
+
+void Diff_Util::composeAnchored(long long aLo, long long aHi, long long bLo, long long bHi) {
+  /* Occurrences of every elem of the window on both sides, with its position in B */
+  typedef struct anchorCount {
+    unsigned aCount;   /**< Occurrences in A */
+    unsigned bCount;   /**< Occurrences in B */
+    long long bAnchor; /**< Position in B */
+  } anchorCount;
+  std::unordered_map<uint32_t, anchorCount> counts;
+  counts.reserve((size_t)(aHi - aLo));
+  for (long long x = aLo; x < aHi; ++x) {
+    anchorCount &count = counts[AIDs[(size_t)x]];
+    ++count.aCount;
+  } // End loop for A window
+  for (long long y = bLo; y < bHi; ++y) {
+    auto count = counts.find(BIDs[(size_t)y]);
+    if (count != counts.end()) {
+      ++count->second.bCount;
+      count->second.bAnchor = y;
+    } // End check for elem in A window
+  }   // End loop for B window
+  /* Elems unique to both sides, in the order of A */
+  std::vector<std::pair<long long, long long>> unique;
+  for (long long x = aLo; x < aHi; ++x) {
+    const anchorCount &count = counts[AIDs[(size_t)x]];
+    if (count.aCount == 1 && count.bCount == 1) {
+      unique.push_back(std::make_pair(x, count.bAnchor));
+    } // End check for unique elem
+  }   // End loop for A window
+  if (unique.empty()) {
+    composeWindow(aLo, aHi, bLo, bHi);
+    return;
+  } // End check for unique elems
+  /* Longest run of unique elems increasing in B, by patience sorting */
+  std::vector<size_t> piles;
+  std::vector<long long> pileTops;
+  std::vector<size_t> previous(unique.size());
+  for (size_t iter = 0; iter < unique.size(); ++iter) {
+    size_t pile = std::lower_bound(pileTops.begin(), pileTops.end(), unique[iter].second) - pileTops.begin();
+    previous[iter] = pile > 0 ? piles[pile - 1] : unique.size();
+    if (pile == piles.size()) {
+      piles.push_back(iter);
+      pileTops.push_back(unique[iter].second);
+    } else {
+      piles[pile] = iter;
+      pileTops[pile] = unique[iter].second;
+    } // End check for new pile
+  }   // End loop for unique elems
+  std::vector<std::pair<long long, long long>> anchors(piles.size());
+  for (size_t iter = piles.back(), pos = piles.size(); pos > 0; iter = previous[iter]) {
+    anchors[--pos] = unique[iter];
+  } // End loop for anchors
+  /* Gaps between the anchors are composed on their own */
+  for (auto anchor : anchors) {
+    composeTrimmed(aLo, anchor.first, bLo, anchor.second);
+    recordEdit(SES_COMMON, anchor.first, anchor.second);
+    aLo = anchor.first + 1;
+    bLo = anchor.second + 1;
+  } // End loop for anchors
+  composeTrimmed(aLo, aHi, bLo, bHi);
+} // End composeAnchored
+
+void Diff_Util::composeWindow(long long aLo, long long aHi, long long bLo, long long bHi) {
+  if (aLo == aHi || bLo == bHi) {
+    for (long long y = bLo; y < bHi; ++y) {
+      recordEdit(SES_ADD, aLo, y);
+    } // End loop for added elems
+    for (long long x = aLo; x < aHi; ++x) {
+      recordEdit(SES_DELETE, x, bLo);
+    } // End loop for deleted elems
+    return;
+  } // End check for empty window
+  windowA = aLo;
+  windowB = bLo;
+  swapped = (aHi - aLo >= bHi - bLo);
+  M = swapped ? bHi - bLo : aHi - aLo;
+  N = swapped ? aHi - aLo : bHi - bLo;
+  delta = N - M;
+  offset = M + 1;
+  /* The coordinates grow with the edit distance, so only the window size is reserved up front */
+  pathCordinates.clear();
+  pathCordinates.reserve(std::min<unsigned long long>(MAX_CORDINATES_SIZE, M + N + 3));
   long long p = -1;
   fp = new long long[M + N + 3];
   std::fill(&fp[0], &fp[M + N + 3], -1);
   path = editPath(M + N + 3);
   fill(path.begin(), path.end(), -1);
-ONP:
   do {
     ++p;
     for (long long k = -p; k <= static_cast<long long>(delta) - 1; ++k) {
@@ -59,6 +164,17 @@ ONP:
     } // End loop for delta - 1
     fp[delta + offset] = snake(static_cast<long long>(delta), fp[delta - 1 + offset] + 1, fp[delta + 1 + offset]);
   } while (fp[delta + offset] != static_cast<long long>(N) && pathCordinates.size() < MAX_CORDINATES_SIZE);
+  bool complete = (fp[delta + offset] == static_cast<long long>(N));
+  delete[] this->fp;
+  this->fp = NULL;
+
+  if (!complete) {
+    /* Coordinate budget exceeded before reaching the end. Start over in linear space */
+    editPathCordinates().swap(pathCordinates);
+    editPath().swap(path);
+    composeLinear(aLo, aHi, bLo, bHi);
+    return;
+  } // End check for complete edit path
 
   long long r = path[delta + offset];
   P cordinate;
@@ -72,39 +188,173 @@ ONP:
   } // End loop for r!= -1
 
   // Record Longest Common Subsequence & Shortest Edit Script
-  if (!recordSequence(epc)) {
-    pathCordinates.resize(0);
-    epc.resize(0);
-    p = -1;
-    goto ONP;
-  } // End check for recordSequence
-  delete[] this->fp;
-} // End compose
+  recordSequence(epc);
+} // End composeWindow
+
+void Diff_Util::composeLinear() { composeLinear(0, AIDs.size(), 0, BIDs.size()); } // End composeLinear
 
-void Diff_Util::init() {
-  M = distance(A.begin(), A.end());
-  N = distance(B.begin(), B.end());
-  if (M < N) {
-    swapped = false;
+void Diff_Util::composeLinear(long long aLo, long long aHi, long long bLo, long long bHi) {
+  /* Furthest reaching x of every diagonal, for the longest range and an edit distance up to half of its size */
+  long long maxD = (aHi - aLo + bHi - bLo + 1) / 2;
+  forwardPath.assign(2 * maxD + 3, -1);
+  backwardPath.assign(2 * maxD + 3, -1);
+  composeRange(aLo, aHi, bLo, bHi);
+  editPath().swap(forwardPath);
+  editPath().swap(backwardPath);
+} // End composeLinear
+
+void Diff_Util::composeRange(long long aLo, long long aHi, long long bLo, long long bHi) {
+  /* Common prefix */
+  while (aLo < aHi && bLo < bHi && isSameElem(aLo, bLo)) {
+    recordEdit(SES_COMMON, aLo, bLo);
+    ++aLo;
+    ++bLo;
+  } // End loop for common prefix
+  /* Common suffix is recorded after the rest of the range */
+  long long suffix = 0;
+  while (aLo < aHi - suffix && bLo < bHi - suffix && isSameElem(aHi - 1 - suffix, bHi - 1 - suffix)) {
+    ++suffix;
+  } // End loop for common suffix
+  aHi -= suffix;
+  bHi -= suffix;
+  if (aLo == aHi) {
+    for (long long y = bLo; y < bHi; ++y) {
+      recordEdit(SES_ADD, aLo, y);
+    } // End loop for added elems
+  } else if (bLo == bHi) {
+    for (long long x = aLo; x < aHi; ++x) {
+      recordEdit(SES_DELETE, x, bLo);
+    } // End loop for deleted elems
   } else {
-    std::swap(A, B);
-    std::swap(M, N);
-    swapped = true;
-  } // End check for M < N
-  delta = N - M;
-  offset = M + 1;
+    long long x, y;
+    findMiddleSnake(aLo, aHi, bLo, bHi, x, y);
+    composeRange(aLo, aLo + x, bLo, bLo + y);
+    composeRange(aLo + x, aHi, bLo + y, bHi);
+  } // End check for empty range
+  for (long long common = 0; common < suffix; ++common) {
+    recordEdit(SES_COMMON, aHi + common, bHi + common);
+  } // End loop for common suffix
+} // End composeRange
+
+void Diff_Util::findMiddleSnake(long long aLo, long long aHi, long long bLo, long long bHi, long long &x,
+                                long long &y) {
+  long long n = aHi - aLo;
+  long long m = bHi - bLo;
+  long long maxD = (n + m + 1) / 2;
+  long long vOffset = maxD;
+  long long vLength = 2 * maxD + 2;
+  std::fill(forwardPath.begin(), forwardPath.begin() + vLength, -1);
+  std::fill(backwardPath.begin(), backwardPath.begin() + vLength, -1);
+  forwardPath[vOffset + 1] = 0;
+  backwardPath[vOffset + 1] = 0;
+  long long diagonal = n - m;
+  /* With an odd diagonal the paths meet while going forward, otherwise while going backward */
+  bool front = (diagonal % 2 != 0);
+  /* Diagonals that ran off the grid are skipped in later rounds */
+  long long forwardStart = 0, forwardEnd = 0, backwardStart = 0, backwardEnd = 0;
+  for (long long d = 0; d < maxD; ++d) {
+    for (long long k = -d + forwardStart; k <= d - forwardEnd; k += 2) {
+      long long kOffset = vOffset + k;
+      long long fx = (k == -d || (k != d && forwardPath[kOffset - 1] < forwardPath[kOffset + 1]))
+                         ? forwardPath[kOffset + 1]
+                         : forwardPath[kOffset - 1] + 1;
+      long long fy = fx - k;
+      while (fx < n && fy < m && isSameElem(aLo + fx, bLo + fy)) {
+        ++fx;
+        ++fy;
+      } // End loop for snake
+      forwardPath[kOffset] = fx;
+      if (fx > n) {
+        forwardEnd += 2;
+      } else if (fy > m) {
+        forwardStart += 2;
+      } else if (front) {
+        long long backwardOffset = vOffset + diagonal - k;
+        if (backwardOffset >= 0 && backwardOffset < vLength && backwardPath[backwardOffset] != -1 &&
+            fx >= n - backwardPath[backwardOffset]) {
+          x = fx;
+          y = fy;
+          return;
+        } // End check for overlap
+      }   // End check for fx and fy
+    }     // End loop for forward diagonals
+    for (long long k = -d + backwardStart; k <= d - backwardEnd; k += 2) {
+      long long kOffset = vOffset + k;
+      long long bx = (k == -d || (k != d && backwardPath[kOffset - 1] < backwardPath[kOffset + 1]))
+                         ? backwardPath[kOffset + 1]
+                         : backwardPath[kOffset - 1] + 1;
+      long long by = bx - k;
+      while (bx < n && by < m && isSameElem(aHi - 1 - bx, bHi - 1 - by)) {
+        ++bx;
+        ++by;
+      } // End loop for snake
+      backwardPath[kOffset] = bx;
+      if (bx > n) {
+        backwardEnd += 2;
+      } else if (by > m) {
+        backwardStart += 2;
+      } else if (!front) {
+        long long forwardOffset = vOffset + diagonal - k;
+        if (forwardOffset >= 0 && forwardOffset < vLength && forwardPath[forwardOffset] != -1) {
+          long long fx = forwardPath[forwardOffset];
+          if (fx >= n - bx) {
+            x = fx;
+            y = fx - (diagonal - k);
+            return;
+          } // End check for overlap
+        }   // End check for forwardOffset
+      }     // End check for bx and by
+    }       // End loop for backward diagonals
+  }         // End loop for d
+  /* Only reached if the ranges share nothing, in which case any split is as good */
+  x = n;
+  y = 0;
+} // End findMiddleSnake
+
+void Diff_Util::recordEdit(int type, long long x, long long y) {
+  switch (type) {
+  case SES_ADD:
+    ses.addSequence(0, y + 1, SES_ADD);
+    break;
+  case SES_DELETE:
+    ses.addSequence(x + 1, 0, SES_DELETE);
+    break;
+  case SES_COMMON:
+    ses.addSequence(x + 1, y + 1, SES_COMMON);
+    break;
+  } // End switch for type
+} // End recordEdit
+
+void Diff_Util::init(const sequence &a, const sequence &b) {
+  M = a.size();
+  N = b.size();
+  swapped = false;
+  windowA = windowB = 0;
   fp = NULL;
+  /* Intern the elems of both sequences into one table */
+  std::unordered_map<elem, uint32_t, elemSpanHash> elemIDs;
+  elemIDs.reserve(M + N);
+  AIDs.reserve(M);
+  BIDs.reserve(N);
+  for (const auto &e : a) {
+    AIDs.push_back(elemIDs.insert(std::make_pair(e, uint32_t(elemIDs.size()))).first->second);
+  } // End loop for A
+  for (const auto &e : b) {
+    BIDs.push_back(elemIDs.insert(std::make_pair(e, uint32_t(elemIDs.size()))).first->second);
+  } // End loop for B
 } // End init
 
 long long Diff_Util::snake(const long long &k, const long long &above, const long long &below) {
   long long r = above > below ? path[(size_t)k - 1 + offset] : path[(size_t)k + 1 + offset];
   long long y = std::max(above, below);
   long long x = y - k;
-  while ((size_t)x < M && (size_t)y < N &&
-         (swapped ? cmp.impl(B[(size_t)y], A[(size_t)x]) : cmp.impl(A[(size_t)x], B[(size_t)y]))) {
+  /* The shorter side of the window runs along x */
+  const uint32_t *XID = wasSwapped() ? BIDs.data() + windowB : AIDs.data() + windowA;
+  const uint32_t *YID = wasSwapped() ? AIDs.data() + windowA : BIDs.data() + windowB;
+  while ((size_t)x < M && (size_t)y < N && XID[x] == YID[y]) {
     ++x;
     ++y;
-  } // End loop for swapped
+  } // End loop for snake
 
   path[(size_t)k + offset] = static_cast<long long>(pathCordinates.size());
   P p;
@@ -115,44 +365,32 @@ long long Diff_Util::snake(const long long &k, const long long &above, const lon
   return y;
 } // End snake
 
-bool Diff_Util::recordSequence(const editPathCordinates &v) {
-  sequence_const_iter x(A.begin());
-  sequence_const_iter y(B.begin());
-  long long x_idx, y_idx;   // line number for Unified Format
-  long long px_idx, py_idx; // cordinates
+void Diff_Util::recordSequence(const editPathCordinates &v) {
+  long long px_idx, py_idx; // cordinates in the window
   bool complete = false;
-  x_idx = y_idx = 1;
   px_idx = py_idx = 0;
   for (size_t i = v.size() - 1; !complete; --i) {
     while (px_idx < v[i].x || py_idx < v[i].y) {
       if (v[i].y - v[i].x > py_idx - px_idx) {
         if (!wasSwapped()) {
-          ses.addSequence(*y, 0, y_idx, SES_ADD);
+          recordEdit(SES_ADD, windowA + px_idx, windowB + py_idx);
         } else {
-          ses.addSequence(*y, y_idx, 0, SES_DELETE);
+          recordEdit(SES_DELETE, windowA + py_idx, windowB + px_idx);
         } // End check for wasSwapped
-        ++y;
-        ++y_idx;
         ++py_idx;
       } else if (v[i].y - v[i].x < py_idx - px_idx) {
         if (!wasSwapped()) {
-          ses.addSequence(*x, x_idx, 0, SES_DELETE);
+          recordEdit(SES_DELETE, windowA + px_idx, windowB + py_idx);
         } else {
-          ses.addSequence(*x, 0, x_idx, SES_ADD);
+          recordEdit(SES_ADD, windowA + py_idx, windowB + px_idx);
         } // End check for wasSwapped
-        ++x;
-        ++x_idx;
         ++px_idx;
       } else {
         if (!wasSwapped()) {
-          ses.addSequence(*x, x_idx, y_idx, SES_COMMON);
+          recordEdit(SES_COMMON, windowA + px_idx, windowB + py_idx);
         } else {
-          ses.addSequence(*y, y_idx, x_idx, SES_COMMON);
+          recordEdit(SES_COMMON, windowA + py_idx, windowB + px_idx);
         } // End check for wasSwapped
-        ++x;
-        ++y;
-        ++x_idx;
-        ++y_idx;
         ++px_idx;
         ++py_idx;
       } // End check for v.y -v.x
@@ -160,24 +398,5 @@ bool Diff_Util::recordSequence(const editPathCordinates &v) {
     if (i == 0)
       complete = true;
   } // End loop for complete
-
-  if (x_idx > static_cast<long long>(M) && y_idx > static_cast<long long>(N)) {
-    // all recording succeeded
-  } else {
-    sequence A_(A.begin() + (size_t)x_idx - 1, A.end());
-    sequence B_(B.begin() + (size_t)y_idx - 1, B.end());
-    A = A_;
-    B = B_;
-    M = distance(A.begin(), A.end());
-    N = distance(B.begin(), B.end());
-    delta = N - M;
-    offset = M + 1;
-    delete[] fp;
-    fp = new long long[M + N + 3];
-    std::fill(&fp[0], &fp[M + N + 3], -1);
-    std::fill(path.begin(), path.end(), -1);
-    return false;
-  } // End check for x_idx
-  return true;
-} // End snake
+} // End recordSequence
 } // namespace hydrogen_framework
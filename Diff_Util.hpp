@@ -6,30 +6,12 @@
 #ifndef DIFF_UTIL_H
 #define DIFF_UTIL_H
 
+#include <cstdint>
+#include <cstring>
 #include <list>
 #include <string>
 #include <vector>
 namespace hydrogen_framework {
-/**
- * DiffCompare Functor class
- */
-class Diff_Compare {
-public:
-  /**
-   * Constructor
-   */
-  Diff_Compare() {}
-  /**
-   * Virtual Destructor
-   */
-  virtual ~Diff_Compare() {}
-  /**
-   * Comparison function
-   * Return TRUE if equal
-   */
-  virtual inline bool impl(const std::string &e1, const std::string &e2) const { return e1 == e2; }
-};
-
 /**
  * Class to hold common/shared type definitions and variables
  */
@@ -69,6 +51,40 @@ public:
     }
   } elemInfo;
 
+  /**
+   * Line held elsewhere, such as in a mapped Source_File, which must outlive it
+   */
+  typedef struct elemspan {
+    const char *data; /**< First character of the line */
+    size_t length;    /**< Number of characters without the line break */
+    /**
+     * Overriding equal operation
+     */
+    bool operator==(const elemspan &other) const {
+      return length == other.length && (length == 0 || std::memcmp(data, other.data, length) == 0);
+    }
+    /**
+     * Return the line as a string
+     */
+    std::string str() const { return std::string(data, length); }
+  } elemSpan;
+
+  /**
+   * Hash of the characters of an elemSpan
+   */
+  typedef struct elemspanhash {
+    /**
+     * Return the FNV-1a hash of e
+     */
+    size_t operator()(const elemspan &e) const {
+      uint64_t hash = 14695981039346656037ULL;
+      for (size_t iter = 0; iter < e.length; ++iter) {
+        hash = (hash ^ static_cast<unsigned char>(e.data[iter])) * 1099511628211ULL;
+      } // End loop for characters
+      return static_cast<size_t>(hash);
+    }
+  } elemSpanHash;
+
   /**
    * Coordinate for registering route
    */
@@ -81,9 +97,9 @@ public:
   const unsigned long long MAX_CORDINATES_SIZE = 2000000;        /**< Limit of coordinate size */
   typedef std::vector<long long> editPath;                       /**< Type definition for editPath */
   typedef std::vector<P> editPathCordinates;                     /**< Type definition for editPathCordinates */
-  typedef std::string elem;                                      /**< Type definition for elem */
+  typedef elemSpan elem;                                         /**< Type definition for elem */
   typedef std::vector<elem> sequence;                            /**< Type definition for sequence */
-  typedef std::pair<elem, elemInfo> sesElem;                     /**< Type definition for sesElem */
+  typedef elemInfo sesElem;                                      /**< Type definition for sesElem. Holds no elem */
   typedef std::vector<sesElem> sesElemVec;                       /**< Type definition for sesElemVec */
   typedef std::list<elem> elemList;                              /**< Type definition for elemList */
   typedef std::vector<elem> elemVec;                             /**< Type definition for elemVec */
@@ -171,12 +187,12 @@ public:
   /**
    * Add sequence
    */
-  void addSequence(elem e, long long beforeIdx, long long afterIdx, const int type);
+  void addSequence(long long beforeIdx, long long afterIdx, const int type);
 
   /**
    * Return sequence
    */
-  sesElemVec getSequence() const { return sequenceDS; }
+  const sesElemVec &getSequence() const { return sequenceDS; }
 
 private:
   sesElemVec sequenceDS; /**< SES sequence */
@@ -200,7 +216,13 @@ public:
   /**
    * Constructor with two arguments
    */
-  Diff_Util(const sequence &a, const sequence &b) : A(a), B(b), ses(false) { init(); }
+  Diff_Util(const sequence &a, const sequence &b) : ses(false), anchored(false) { init(a, b); }
+
+  /**
+   * Constructor with three arguments
+   * When anchored is TRUE, compose anchors on the elems that occur once in both sequences
+   */
+  Diff_Util(const sequence &a, const sequence &b, bool anchored) : ses(false), anchored(anchored) { init(a, b); }
 
   /**
    * Destructor
@@ -210,32 +232,70 @@ public:
   /**
    * Return ses
    */
-  Diff_Ses getSes() const { return ses; }
+  const Diff_Ses &getSes() const { return ses; }
 
   /**
    * Compose Longest Common Subsequence and Shortest Edit Script.
+   * The common prefix and suffix are recorded first and only the window between them is searched
    * The algorithm implemented here is based on "An O(NP) Sequence Comparison Algorithm"
    * described by Sun Wu, Udi Manber and Gene Myers
+   * Falls back to composeLinear on a window whose edit path needs more than MAX_CORDINATES_SIZE coordinates
+   * When anchored, the window is first split around the elems unique to both sequences, as in patience diff.
+   * This is faster on large files with scattered changes but the script may no longer be the shortest
    */
   void compose();
 
+  /**
+   * Compose Shortest Edit Script in memory linear to the input.
+   * Divide and conquer around the middle snake, from "An O(ND) Difference Algorithm and Its Variations"
+   * described by Eugene W. Myers
+   */
+  void composeLinear();
+
 private:
-  sequence A;                        /**< First sequence */
-  sequence B;                        /**< Second sequence */
-  size_t M;                          /**< M value */
-  size_t N;                          /**< N value */
+  size_t M;                          /**< Length of the shorter side of the window */
+  size_t N;                          /**< Length of the longer side of the window */
   size_t delta;                      /**< Delta */
   size_t offset;                     /**< offset */
   long long *fp;                     /**< Pointer to elem */
   Diff_Ses ses;                      /**< Shortest edit scrit */
   editPath path;                     /**< Edit path */
   editPathCordinates pathCordinates; /**< Edit path coordinates */
-  bool swapped;                      /**< Flag to check if sequence are swapped */
-  Diff_Compare cmp;                  /**< Comparison Functor */
+  editPath forwardPath;              /**< Furthest x on every diagonal reached from the start by composeLinear */
+  editPath backwardPath;             /**< Furthest x on every diagonal reached from the end by composeLinear */
+  bool anchored;                     /**< Flag to anchor on the elems unique to both sequences */
+  bool swapped;                      /**< Flag to check if the window of B is the shorter side */
+  long long windowA;                 /**< Start of the window in A */
+  long long windowB;                 /**< Start of the window in B */
+  std::vector<uint32_t> AIDs;        /**< Interned ID of every elem in the first sequence, A */
+  std::vector<uint32_t> BIDs;        /**< Interned ID of every elem in the second sequence, B */
   /**
    * Initialize
+   * Equal elems of a and b are interned to the same ID, so that comparing them is comparing the IDs
+   * Only the IDs are kept. The SES refers to the elems by their position
+   */
+  void init(const sequence &a, const sequence &b);
+
+  /**
+   * Record SES of A[aLo, aHi) and B[bLo, bHi) after taking out their common prefix and suffix
    */
-  void init();
+  void composeTrimmed(long long aLo, long long aHi, long long bLo, long long bHi);
+
+  /**
+   * Record SES of A[aLo, aHi) and B[bLo, bHi) by matching the elems that occur once in both first
+   * The longest run of such elems appearing in the same order is kept and the gaps between them are composed
+   */
+  void composeAnchored(long long aLo, long long aHi, long long bLo, long long bHi);
+
+  /**
+   * Record SES of A[aLo, aHi) and B[bLo, bHi) with the O(NP) search, the shorter side taking the place of A
+   */
+  void composeWindow(long long aLo, long long aHi, long long bLo, long long bHi);
+
+  /**
+   * Record SES of A[aLo, aHi) and B[bLo, bHi) in memory linear to the window
+   */
+  void composeLinear(long long aLo, long long aHi, long long bLo, long long bHi);
 
   /**
    * Search shortest path and record the path
@@ -243,12 +303,33 @@ private:
   long long snake(const long long &k, const long long &above, const long long &below);
 
   /**
-   * Record SES
+   * Record SES of the window from the edit path found by compose
+   */
+  void recordSequence(const editPathCordinates &v);
+
+  /**
+   * Record a single edit at position x of A and y of B
+   */
+  void recordEdit(int type, long long x, long long y);
+
+  /**
+   * Return TRUE if the elem at position x of A equals the one at position y of B
+   */
+  bool isSameElem(long long x, long long y) const { return AIDs[(size_t)x] == BIDs[(size_t)y]; }
+
+  /**
+   * Record SES of A[aLo, aHi) and B[bLo, bHi) by splitting them around their middle snake
+   */
+  void composeRange(long long aLo, long long aHi, long long bLo, long long bHi);
+
+  /**
+   * Find where the middle snake of A[aLo, aHi) and B[bLo, bHi) overlaps a shortest edit path from both ends
+   * Both ranges must be non empty. The point is returned in x and y, relative to aLo and bLo
    */
-  bool recordSequence(const editPathCordinates &v);
+  void findMiddleSnake(long long aLo, long long aHi, long long bLo, long long bHi, long long &x, long long &y);
 
   /**
-   * Check if the sequences have been swapped
+   * Check if the sides of the window have been swapped
    */
   bool inline wasSwapped() const { return swapped; }
 }; // End Diff Class
@@ -6,9 +6,74 @@
 #include "Get_Input.hpp"
 #include "Diff_Mapping.hpp"
 #include "Module.hpp"
+#include "Verify_Cache.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <thread>
 namespace hydrogen_framework {
+bool Hydrogen::parseOptions(int c, char *files[]) {
+  for (hydrogenArgStart = 1; hydrogenArgStart < c; ++hydrogenArgStart) {
+    std::string option = files[hydrogenArgStart];
+    if (option.compare(0, 2, "--") != 0) {
+      break;
+    } // End check for option prefix
+    std::size_t split = option.find('=');
+    std::string name = option.substr(2, split == std::string::npos ? std::string::npos : split - 2);
+    std::string value = split == std::string::npos ? "" : option.substr(split + 1);
+    if (name == "threads" && parseNumber(value, hydrogenThreads)) {
+      /* More threads than this only cost memory for the chunks printed in parallel */
+      hydrogenThreads = std::min(hydrogenThreads, 4 * std::max(1u, std::thread::hardware_concurrency()));
+    } else if (name == "pipeline" && parseNumber(value, hydrogenPipelineDepth)) {
+      /* parseNumber has set hydrogenPipelineDepth */
+    } else if (name == "lazy" && split == std::string::npos) {
+      hydrogenLazy = true;
+    } else if (name == "patience" && split == std::string::npos) {
+      hydrogenPatience = true;
+    } else if (name == "no-verify" && split == std::string::npos) {
+      hydrogenVerify = false;
+    } else if (name == "verify-cache" && !value.empty()) {
+      hydrogenVerifyCache = new Verify_Cache(value);
+      hydrogenVerifyCache->loadCache();
+    } else if (name == "save-snapshot" && !value.empty()) {
+      hydrogenSnapshotFile = value;
+    } else if (name == "append" && !value.empty()) {
+      hydrogenAppendFile = value;
+    } else if (name == "compress" && (value == "gzip" || value == "zstd")) {
+      hydrogenCompression = value == "gzip" ? Graph_Writer::GZIP : Graph_Writer::ZSTD;
+      if (!Graph_Writer::isCompressionAvailable(hydrogenCompression)) {
+        std::cerr << "Hydrogen was built without " << value << " support\n";
+        return false;
+      } // End check for isCompressionAvailable
+    } else if (name == "format" && Graph_Exporter::parseFormat(value, hydrogenFormat)) {
+      /* parseFormat has set hydrogenFormat */
+    } else if (name == "output" && !value.empty()) {
+      hydrogenOutput = value;
+    } else {
+      std::cerr << "Unknown or malformed option " << option << "\n"
+                << "Please recheck the input\n";
+      return false;
+    } // End check for option name
+  }   // End loop for options
+  return true;
+} // End parseOptions
+
+bool Hydrogen::parseNumber(const std::string &value, unsigned &number) {
+  /* strtoul would also take signs and leading spaces */
+  if (value.empty() || !std::all_of(value.begin(), value.end(), ::isdigit)) {
+    return false;
+  } // End check for digits
+  errno = 0;
+  unsigned long parsed = std::strtoul(value.c_str(), NULL, 10);
+  if (errno == ERANGE || parsed > std::numeric_limits<unsigned>::max()) {
+    return false;
+  } // End check for range
+  number = parsed;
+  return true;
+} // End parseNumber
+
 bool Hydrogen::validateInputs(int c, char *files[]) {
-  for (int index = 1; index < c; index++) {
+  for (int index = hydrogenArgStart; index < c; index++) {
     std::string file = files[index];
     struct stat buffer;
     int status = stat(file.c_str(), &buffer);
@@ -27,7 +92,7 @@ bool Hydrogen::validateInputs(int c, char *files[]) {
 bool Hydrogen::processInputs(int c, char *files[]) {
   int countModules = 0;
   /* Getting all the modules first */
-  int index = 1;
+  int index = hydrogenArgStart;
   for (; index < c; ++index) {
     std::string file = files[index];
     if (file == hydrogenDemarcation) {
@@ -35,13 +100,17 @@ bool Hydrogen::processInputs(int c, char *files[]) {
     } // End check for hydrogenDemarcation
     countModules++;
     Module *module = new Module();
-    if (!module->setModule(countModules, file)) {
+    module->setVerification(hydrogenVerify, hydrogenVerifyCache);
+    if (hydrogenLazy) {
+      module->setLazyModule(countModules, file);
+    } else if (!module->setModule(countModules, file)) {
       return false;
     } // End check for module
     hydrogenModules.push_back(module);
   } // End module loop
   /* Getting the files associated with it */
-  bool filesForAllVersions = false;
+  /* A single module has nothing to be merged with unless it is appended to a snapshot */
+  bool filesForAllVersions = (countModules == 1 && !hydrogenAppendFile.empty());
   for (int i = 1; i <= countModules; ++i) {
     std::list<std::string> versionFiles;
     for (++index; index < c; ++index) {
@@ -6,6 +6,8 @@
 #ifndef GET_INPUT_H
 #define GET_INPUT_H
 
+#include "Graph_Exporter.hpp"
+#include "Graph_Writer.hpp"
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
@@ -14,6 +16,7 @@
 namespace hydrogen_framework {
 /* Forward declaration */
 class Module;
+class Verify_Cache;
 
 /**
  * Hydrogen Class: Hydrogen Framework data structures and functions
@@ -24,13 +27,25 @@ public:
    * Constructor for hydrogen class
    * Sets the demarcation variable
    */
-  Hydrogen() { hydrogenDemarcation = "::"; }
+  Hydrogen()
+      : hydrogenArgStart(1), hydrogenThreads(1), hydrogenPipelineDepth(0), hydrogenLazy(false), hydrogenPatience(false),
+        hydrogenVerify(true), hydrogenVerifyCache(NULL), hydrogenCompression(Graph_Writer::NONE),
+        hydrogenFormat(Graph_Exporter::DOT) {
+    hydrogenDemarcation = "::";
+    hydrogenOutput = "MVICFG";
+  }
 
   /**
    * Destructor
    */
   ~Hydrogen() { hydrogenModules.clear(); }
 
+  /**
+   * Parse the options given before the inputs. Options are of the form --name=value
+   * Returns FALSE if an unknown or malformed option is found.
+   */
+  bool parseOptions(int c, char *files[]);
+
   /**
    * Validate provided inputs.
    * Returns FALSE if any of the provided input is not present.
@@ -48,9 +63,82 @@ public:
    */
   std::list<Module *> getModules() { return hydrogenModules; }
 
+  /**
+   * Return hydrogenThreads
+   */
+  unsigned getThreads() { return hydrogenThreads; }
+
+  /**
+   * Return hydrogenPipelineDepth
+   */
+  unsigned getPipelineDepth() { return hydrogenPipelineDepth; }
+
+  /**
+   * Return hydrogenLazy
+   */
+  bool isLazy() { return hydrogenLazy; }
+
+  /**
+   * Return hydrogenPatience
+   */
+  bool isPatience() { return hydrogenPatience; }
+
+  /**
+   * Return hydrogenVerifyCache
+   * Can return NULL
+   */
+  Verify_Cache *getVerifyCache() { return hydrogenVerifyCache; }
+
+  /**
+   * Return hydrogenSnapshotFile
+   * Empty if no snapshot is to be saved
+   */
+  std::string getSnapshotFile() { return hydrogenSnapshotFile; }
+
+  /**
+   * Return hydrogenAppendFile
+   * Empty if the MVICFG is built from the first module
+   */
+  std::string getAppendFile() { return hydrogenAppendFile; }
+
+  /**
+   * Return hydrogenCompression
+   */
+  Graph_Writer::writerCompression getCompression() { return hydrogenCompression; }
+
+  /**
+   * Return hydrogenFormat
+   */
+  Graph_Exporter::exporterFormat getFormat() { return hydrogenFormat; }
+
+  /**
+   * Return hydrogenOutput
+   */
+  std::string getOutput() { return hydrogenOutput; }
+
 private:
   std::string hydrogenDemarcation;     /**< Setting demarcation string for inputs */
   std::list<Module *> hydrogenModules; /**< Container for storing LLVM Modules */
-};                                     // End hydrogen class
+  int hydrogenArgStart;                /**< Index of the first input after the options */
+  unsigned hydrogenThreads;            /**< Number of threads to use. Zero means all hardware threads */
+  unsigned hydrogenPipelineDepth;      /**< Number of versions prepared ahead of the merge. Zero disables it */
+  bool hydrogenLazy;                   /**< Parse modules only when needed and free them after merging */
+  bool hydrogenPatience;               /**< Anchor the diff of every file on its unique lines */
+  bool hydrogenVerify;                 /**< Verify the modules when they are parsed */
+  Verify_Cache *hydrogenVerifyCache;   /**< Hashes of modules verified in earlier runs. Can be NULL */
+  std::string hydrogenSnapshotFile;    /**< File to save the MVICFG snapshot into */
+  std::string hydrogenAppendFile;      /**< Snapshot of the MVICFG to which the modules are appended */
+  Graph_Writer::writerCompression
+      hydrogenCompression; /**< Compression of the printed MVICFG */
+  Graph_Exporter::exporterFormat
+      hydrogenFormat;                  /**< Format of the printed MVICFG */
+  std::string hydrogenOutput;          /**< Path of the printed MVICFG without its extension */
+
+  /**
+   * Parse value as a decimal unsigned number into number
+   * Returns FALSE if value has anything but digits or does not fit, leaving number unchanged
+   */
+  bool parseNumber(const std::string &value, unsigned &number);
+}; // End hydrogen class
 } // namespace hydrogen_framework
 #endif
@@ -4,24 +4,114 @@
  * Implementing Graph.hpp
  */
 #include "Graph.hpp"
+#include "Graph_Compact.hpp"
 #include "Graph_Edge.hpp"
 #include "Graph_Function.hpp"
 #include "Graph_Instruction.hpp"
 #include "Graph_Line.hpp"
+#include "Thread_Pool.hpp"
 namespace hydrogen_framework {
+const unsigned Graph::printWindow;
+const uint32_t Graph::printEdgeChunk;
+
 void Graph::pushGraphFunction(Graph_Function *func) {
   func->setGraph(this);
   graphFunctions.push_back(func);
+  for (auto line : func->getFunctionLines()) {
+    indexGraphLine(line);
+  } // End loop for line
 } // End pushGraphFunction
 
+void Graph::indexGraphLine(Graph_Line *line) {
+  for (auto inst : line->getLineInstructions()) {
+    llvm::Instruction *I = inst->getInstructionPtr();
+    /* Virtual nodes do not have LLVM Instruction */
+    if (I) {
+      instructionMap.insert(std::pair<llvm::Instruction *, Graph_Instruction *>(I, inst));
+    } // End check for I
+  }   // End loop for inst
+  for (auto ver : line->getLineVersions()) {
+    indexLineNumber(line, ver, line->getLineNumber(ver));
+  } // End loop for ver
+} // End indexGraphLine
+
+void Graph::indexLineNumber(Graph_Line *line, unsigned version, unsigned lineNo) {
+  lineKey key;
+  key.fileID = getFileID(line->getGraphFunction()->getFunctionFile());
+  key.version = version;
+  key.lineNo = lineNo;
+  graphLineMap[key].push_back(line);
+  /* Zero marks a line that is not present in the version */
+  if (lineNo != 0) {
+    if (version >= versionLines.size()) {
+      versionLines.resize(version + 1);
+    } // End check for versionLines size
+    versionLines[version].push_back(line);
+  } // End check for lineNo
+} // End indexLineNumber
+
+void Graph::indexEdgeVersion(Graph_Edge *edge, unsigned version) {
+  if (version >= versionEdges.size()) {
+    versionEdges.resize(version + 1);
+  } // End check for versionEdges size
+  versionEdges[version].push_back(edge);
+} // End indexEdgeVersion
+
+const std::vector<Graph_Edge *> &Graph::getVersionEdges(unsigned version) const {
+  static const std::vector<Graph_Edge *> noEdges;
+  if (version >= versionEdges.size()) {
+    return noEdges;
+  } // End check for version
+  return versionEdges[version];
+} // End getVersionEdges
+
+const std::vector<Graph_Line *> &Graph::getVersionLines(unsigned version) const {
+  static const std::vector<Graph_Line *> noLines;
+  if (version >= versionLines.size()) {
+    return noLines;
+  } // End check for version
+  return versionLines[version];
+} // End getVersionLines
+
+const std::vector<Graph_Line *> &Graph::getGraphLines(std::string fileName, unsigned version, unsigned lineNo) {
+  static const std::vector<Graph_Line *> noLines;
+  auto findFile = fileIDs.find(fileName);
+  if (findFile == fileIDs.end()) {
+    return noLines;
+  } // End check for findFile
+  lineKey key;
+  key.fileID = findFile->second;
+  key.version = version;
+  key.lineNo = lineNo;
+  auto findLines = graphLineMap.find(key);
+  if (findLines == graphLineMap.end()) {
+    return noLines;
+  } // End check for findLines
+  return findLines->second;
+} // End getGraphLines
+
+unsigned Graph::getFileID(std::string fileName) {
+  auto findFile = fileIDs.find(fileName);
+  if (findFile != fileIDs.end()) {
+    return findFile->second;
+  } // End check for findFile
+  unsigned fileID = fileIDs.size();
+  fileIDs.insert(std::pair<std::string, unsigned>(fileName, fileID));
+  return fileID;
+} // End getFileID
+
 void Graph::addEdge(Graph_Instruction *from, Graph_Instruction *to, Graph_Edge *edge) {
   from->pushEdgeInstruction(edge);
   to->pushEdgeInstruction(edge);
   pushGraphEdges(edge);
+  edge->setEdgeGraph(this);
+  for (auto ver : edge->getEdgeVersions()) {
+    indexEdgeVersion(edge, ver);
+  } // End loop for ver
 } // End addEdge
 
 void Graph::addSeqEdges(Graph_Line *line) {
-  std::list<Graph_Instruction *> instructions = line->getLineInstructions();
+  const std::vector<Graph_Instruction *> &instructions = line->getLineInstructions();
   for (auto inst = instructions.begin(), instEnd = instructions.end(); inst != instEnd; ++inst) {
     /* Double check to make sure it is not Br */
     llvm::Instruction *llvmInst = (*inst)->getInstructionPtr();
@@ -32,60 +122,60 @@ void Graph::addSeqEdges(Graph_Line *line) {
     }   // End check for llvmInst
     auto nextInst = std::next(inst);
     if (nextInst != instEnd) {
-      Graph_Edge *seqEdge = new Graph_Edge(*inst, *nextInst, Graph_Edge::SEQUENTIAL, graphVersion);
+      Graph_Edge *seqEdge = graphArena.newEdge(*inst, *nextInst, Graph_Edge::SEQUENTIAL, graphVersion);
       addEdge(*inst, *nextInst, seqEdge);
     } // End check for instEnd
   }   // End loop for inst
 } // End addSeqEdges
 
 Graph_Instruction *Graph::findMatchedInstruction(llvm::Instruction *matchInst) {
-  for (auto func : graphFunctions) {
-    for (auto line : func->getFunctionLines()) {
-      for (auto inst : line->getLineInstructions()) {
-        if (inst->getInstructionPtr() == matchInst) {
-          return inst;
-        } // End check for matchInst
-      }   // End loop for inst
-    }     // End loop for line
-  }       // End loop for func
+  auto findInst = instructionMap.find(matchInst);
+  if (findInst != instructionMap.end()) {
+    return findInst->second;
+  } // End check for findInst
   return NULL;
 } // End findMatchedInstruction
 
+void Graph::detachInstructions() {
+  /* Instructions of functions that never joined the Graph are not in instructionMap but can still print labels */
+  graphArena.visitInstructions([](Graph_Instruction *inst) -> void { inst->detachInstructionPtr(); });
+  /* Freed addresses can be reused by the next module, so the stale keys must go as well */
+  instructionMap.clear();
+} // End detachInstructions
+
+void Graph::detachInstructions(const std::list<Graph_Line *> &lines) {
+  for (auto line : lines) {
+    for (auto inst : line->getLineInstructions()) {
+      llvm::Instruction *I = inst->getInstructionPtr();
+      if (I) {
+        instructionMap.erase(I);
+        inst->detachInstructionPtr();
+      } // End check for I
+    }   // End loop for inst
+  }     // End loop for line
+} // End detachInstructions
+
 Graph_Instruction *Graph::findVirtualEntry(std::string funcName) {
-  for (auto func : graphFunctions) {
-    if (func->getFunctionName() == funcName) {
-      for (auto line : func->getFunctionLines()) {
-        for (auto inst : line->getLineInstructions()) {
-          if (inst->getInstructionLabel().find("Entry::") != std::string::npos) {
-            return inst;
-          } // End check for matchInst
-        }   // End loop for inst
-      }     // End loop for line
-    }       // End check for function name
-  }         // End loop for func
-  return NULL;
+  auto virtualNodes = virtualNodeMap.find(funcName);
+  if (virtualNodes == virtualNodeMap.end()) {
+    return NULL;
+  } // End check for virtualNodeMap
+  return virtualNodes->second.first;
 } // End findVirtualEntry
 
 Graph_Instruction *Graph::findVirtualExit(std::string funcName) {
-  for (auto func : graphFunctions) {
-    if (func->getFunctionName() == funcName) {
-      for (auto line : func->getFunctionLines()) {
-        for (auto inst : line->getLineInstructions()) {
-          if (inst->getInstructionLabel().find("Exit::") != std::string::npos) {
-            return inst;
-          } // End check for Exit
-        }   // End loop for inst
-      }     // End loop for line
-    }       // End check for function name
-  }         // End loop for func
-  return NULL;
+  auto virtualNodes = virtualNodeMap.find(funcName);
+  if (virtualNodes == virtualNodeMap.end()) {
+    return NULL;
+  } // End check for virtualNodeMap
+  return virtualNodes->second.second;
 } // End findVirtualExit
 
 void Graph::addBranchEdges() {
   for (auto func : graphFunctions) {
-    std::list<Graph_Line *> lines = func->getFunctionLines();
+    const std::vector<Graph_Line *> &lines = func->getFunctionLines();
     for (auto line = lines.begin(); line != lines.end(); ++line) {
-      std::list<Graph_Instruction *> instructions = (*line)->getLineInstructions();
+      const std::vector<Graph_Instruction *> &instructions = (*line)->getLineInstructions();
       for (auto inst = instructions.begin(); inst != instructions.end(); ++inst) {
         llvm::Instruction *I = (*inst)->getInstructionPtr();
         if (I) {
@@ -96,7 +186,7 @@ void Graph::addBranchEdges() {
               llvm::Instruction *iSucc = llvm::dyn_cast<llvm::Instruction>(I->getSuccessor(iterSucc)->begin());
               Graph_Instruction *iSuccInst = findMatchedInstruction(iSucc);
               if (iSucc) {
-                Graph_Edge *branchEdge = new Graph_Edge(*inst, iSuccInst, Graph_Edge::BRANCH, graphVersion);
+                Graph_Edge *branchEdge = graphArena.newEdge(*inst, iSuccInst, Graph_Edge::BRANCH, graphVersion);
                 addEdge(*inst, iSuccInst, branchEdge);
               } else {
                 std::cerr << "No matching Graph_Instruction found for edge from " << (*inst)->getInstructionLabel()
@@ -107,10 +197,10 @@ void Graph::addBranchEdges() {
             /* Adding Unique successors */
             auto nextLine = std::next(line);
             if (nextLine != lines.end()) {
-              std::list<Graph_Instruction *> nextInstructions = (*nextLine)->getLineInstructions();
+              const std::vector<Graph_Instruction *> &nextInstructions = (*nextLine)->getLineInstructions();
               auto nextI = nextInstructions.begin();
               if (nextI != nextInstructions.end()) {
-                Graph_Edge *seqEdge = new Graph_Edge(*inst, *nextI, Graph_Edge::SEQUENTIAL, graphVersion);
+                Graph_Edge *seqEdge = graphArena.newEdge(*inst, *nextI, Graph_Edge::SEQUENTIAL, graphVersion);
                 addEdge(*inst, *nextI, seqEdge);
               } // End check for nextI
             }   // End check for nextLine
@@ -123,22 +213,20 @@ void Graph::addBranchEdges() {
 
 void Graph::addFunctionCallEdges() {
   /* External Node */
-  Graph_Function *virtualNodeFunc = new Graph_Function(getNextID());
+  Graph_Function *virtualNodeFunc = graphArena.newFunction(getNextID());
   virtualNodeFunc->setFunctionFile("External_Node_File");
   virtualNodeFunc->setFunctionName("External_Node_Func");
-  Graph_Line *virtualNodeLine = new Graph_Line(graphVersion);
+  Graph_Line *virtualNodeLine = graphArena.newLine(graphVersion);
   virtualNodeLine->setLineNumber(graphVersion, graphEntryID);
-  Graph_Instruction *externalNode = new Graph_Instruction();
+  Graph_Instruction *externalNode = graphArena.newInstruction();
   externalNode->setInstructionID(getNextID());
   externalNode->setInstructionLabel("External_Node");
   externalNode->setInstructionPtr(NULL);
   virtualNodeLine->pushLineInstruction(externalNode);
   virtualNodeFunc->pushFunctionLines(virtualNodeLine);
   pushGraphFunction(virtualNodeFunc);
-  std::list<std::string> funcNotFoud;
-  /* Get the whitelisted function names and merge with funcNotFoud */
-  std::list<std::string> whiteListedFunc = Graph::getWhiteList();
-  funcNotFoud.insert(funcNotFoud.end(), whiteListedFunc.begin(), whiteListedFunc.end());
+  /* Functions not to warn about. Starts with the whitelisted ones and grows with those already reported */
+  std::unordered_set<std::string> funcNotFoud(whiteList.begin(), whiteList.end());
   for (auto func : graphFunctions) {
     for (auto line : func->getFunctionLines()) {
       for (auto inst : line->getLineInstructions()) {
@@ -148,7 +236,7 @@ void Graph::addFunctionCallEdges() {
             const llvm::Function *Callee = callSite.getCalledFunction();
             if (!Callee || !llvm::Intrinsic::isLeaf(Callee->getIntrinsicID())) {
               /* Call Extern */
-              Graph_Edge *callEdge = new Graph_Edge(inst, externalNode, Graph_Edge::EXTERNAL_CALL, graphVersion);
+              Graph_Edge *callEdge = graphArena.newEdge(inst, externalNode, Graph_Edge::EXTERNAL_CALL, graphVersion);
               addEdge(inst, externalNode, callEdge);
             } else if (!Callee->isIntrinsic()) {
               /* Add Edge based on function name */
@@ -159,7 +247,7 @@ void Graph::addFunctionCallEdges() {
                 /* Call site to Entry */
                 Graph_Instruction *virtualEntry = findVirtualEntry(funcName);
                 if (virtualEntry) {
-                  Graph_Edge *callEdge = new Graph_Edge(inst, virtualEntry, Graph_Edge::CALL, graphVersion);
+                  Graph_Edge *callEdge = graphArena.newEdge(inst, virtualEntry, Graph_Edge::CALL, graphVersion);
                   addEdge(inst, virtualEntry, callEdge);
                 } else {
                   noEntry = true;
@@ -167,16 +255,14 @@ void Graph::addFunctionCallEdges() {
                 /* Exit to Call site */
                 Graph_Instruction *virtualExit = findVirtualExit(funcName);
                 if (virtualExit) {
-                  Graph_Edge *callEdge = new Graph_Edge(virtualExit, inst, Graph_Edge::CALL, graphVersion);
+                  Graph_Edge *callEdge = graphArena.newEdge(virtualExit, inst, Graph_Edge::CALL, graphVersion);
                   addEdge(virtualExit, inst, callEdge);
                 } else {
                   noExit = true;
                 } // End check for virtualExit
-                auto findFunc = std::find_if(std::begin(funcNotFoud), std::end(funcNotFoud),
-                                             [=](std::string name) { return name == funcName; });
-                if (findFunc == funcNotFoud.end()) {
+                if (!funcNotFoud.count(funcName)) {
                   if (noEntry && noExit) {
-                    funcNotFoud.push_back(funcName);
+                    funcNotFoud.insert(funcName);
                     std::cerr << "Call edges not formed for " << funcName << "\n";
                   } else if (noEntry) {
                     std::cerr << "No Virtual Entry found for " << funcName << "\n";
@@ -197,101 +283,165 @@ void Graph::addFunctionCallEdges() {
 
 void Graph::addVirtualNodes(Graph_Function *func) {
   std::string funcName = func->getFunctionName();
-  Graph_Line *virtualLine = new Graph_Line(graphVersion);
+  Graph_Line *virtualLine = graphArena.newLine(graphVersion);
   /* Entry Node */
   virtualLine->setLineNumber(graphVersion, graphEntryID);
-  Graph_Instruction *virtualNode = new Graph_Instruction();
+  Graph_Instruction *virtualNode = graphArena.newInstruction();
   virtualNode->setInstructionID(getNextID());
   virtualNode->setInstructionLabel("Entry::" + funcName);
   virtualNode->setInstructionPtr(NULL);
   virtualLine->pushLineInstruction(virtualNode);
+  Graph_Instruction *entryNode = virtualNode;
   auto *to = func->getFunctionLines().front()->getLineInstructions().front();
   func->pushFrontFunctionLines(virtualLine);
-  Graph_Edge *virtualEdgeEntry = new Graph_Edge(virtualNode, to, Graph_Edge::VIRTUAL, graphVersion);
+  Graph_Edge *virtualEdgeEntry = graphArena.newEdge(virtualNode, to, Graph_Edge::VIRTUAL, graphVersion);
   addEdge(virtualNode, to, virtualEdgeEntry);
   /* Exit Node */
-  virtualLine = new Graph_Line(graphVersion);
+  virtualLine = graphArena.newLine(graphVersion);
   virtualLine->setLineNumber(graphVersion, graphExitID);
-  virtualNode = new Graph_Instruction();
+  virtualNode = graphArena.newInstruction();
   virtualNode->setInstructionID(getNextID());
   virtualNode->setInstructionLabel("Exit::" + funcName);
   virtualNode->setInstructionPtr(NULL);
   virtualLine->pushLineInstruction(virtualNode);
   auto *from = func->getFunctionLines().back()->getLineInstructions().back();
   func->pushFunctionLines(virtualLine);
-  Graph_Edge *virtualEdgeExit = new Graph_Edge(from, virtualNode, Graph_Edge::VIRTUAL, graphVersion);
+  Graph_Edge *virtualEdgeExit = graphArena.newEdge(from, virtualNode, Graph_Edge::VIRTUAL, graphVersion);
   addEdge(from, virtualNode, virtualEdgeExit);
+  /* Call edges go to the first function of a name, as they did when functions were searched in order */
+  virtualNodeMap.insert(std::make_pair(funcName, std::make_pair(entryNode, virtualNode)));
 } // End addVirtualNodes
 
 void Graph::printGraph(std::string graphName) {
-  std::ofstream gFile(graphName + ".dot", std::ios::trunc);
-  if (!gFile.is_open()) {
+  printGraph(graphName, Graph_Writer::NONE, 1);
+} // End printGraph
+
+bool Graph::printGraph(std::string graphName, Graph_Writer::writerCompression compression, unsigned threads) {
+  Graph_Writer gFile;
+  if (!gFile.openWriter(graphName + ".dot", compression)) {
     std::cerr << "Unable to open file for printing the output\n";
-    return;
+    return false;
   } // End check for gFile
   /* Initialize graph */
-  gFile << "digraph \"MVICFG\" {\n";
-  gFile << "\tlabel=\"" << graphName << "\";\n";
+  gFile.write("digraph \"MVICFG\" {\n");
+  gFile.write("\tlabel=\"" + graphName + "\";\n");
   /* Generating Nodes */
-  gFile << "/* Generating Nodes */\n";
-  for (auto func : graphFunctions) {
-    gFile << "\tsubgraph cluster_" << func->getFunctionID() << " {\n";
-    gFile << "\t\tlabel=\"" << func->getFunctionName() << "\";\n";
-    for (auto line : func->getFunctionLines()) {
-      for (auto inst : line->getLineInstructions()) {
-        std::string outputString = std::regex_replace(inst->getInstructionLabel(), std::regex("\""), "\\\"");
-        gFile << "\t\t\"" << inst->getInstructionID() << "\" [label=\"" << line->getLineNumber(graphVersion)
-              << "::" << outputString << "\"];\n";
-      } // End loop for inst
-    }   // End loop for line
-    gFile << "\t}\n";
-  } // End loop for func
+  gFile.write("/* Generating Nodes */\n");
+  Graph_Compact compact(this);
+  Thread_Pool pool(threads);
+  /* Chunks are built a window at a time and written in order, so the output does not depend on the threads */
+  std::size_t window = pool.getThreads() * printWindow;
+  std::vector<std::string> chunks(window);
+  for (uint32_t first = 0; first < compact.getFunctionCount(); first += window) {
+    std::size_t count = std::min<std::size_t>(window, compact.getFunctionCount() - first);
+    pool.parallelFor(count, [&](size_t index) {
+      chunks[index].clear();
+      printFunctionChunk(compact, first + index, chunks[index]);
+    });
+    for (std::size_t index = 0; index < count; ++index) {
+      gFile.write(chunks[index]);
+    } // End loop for chunks
+  }   // End loop for functions
   /* Generating Edges*/
-  gFile << "\n/* Generating Edges */\n";
-  for (auto edge : graphEdges) {
-    std::string outputString = "\t\t\"" + std::to_string(edge->getEdgeFrom()->getInstructionID()) + "\" -> \"" +
-                               std::to_string(edge->getEdgeTo()->getInstructionID());
-    switch (edge->getEdgeType()) {
+  gFile.write("\n/* Generating Edges */\n");
+  uint32_t edgeChunks = (compact.getEdgeCount() + printEdgeChunk - 1) / printEdgeChunk;
+  for (uint32_t first = 0; first < edgeChunks; first += window) {
+    std::size_t count = std::min<std::size_t>(window, edgeChunks - first);
+    pool.parallelFor(count, [&](size_t index) {
+      uint32_t firstEdge = (first + index) * printEdgeChunk;
+      uint32_t lastEdge = std::min<uint32_t>(firstEdge + printEdgeChunk, compact.getEdgeCount());
+      chunks[index].clear();
+      printEdgesChunk(compact, firstEdge, lastEdge, chunks[index]);
+    });
+    for (std::size_t index = 0; index < count; ++index) {
+      gFile.write(chunks[index]);
+    } // End loop for chunks
+  }   // End loop for edges
+  /* Finalizing graph */
+  gFile.write("}\n");
+  return gFile.closeWriter();
+} // End printGraph
+
+void Graph::printFunctionChunk(const Graph_Compact &compact, uint32_t func, std::string &chunk) {
+  chunk.append("\tsubgraph cluster_");
+  Graph_Writer::appendUnsigned(chunk, compact.getFunction(func)->getFunctionID());
+  chunk.append(" {\n\t\tlabel=\"");
+  chunk.append(compact.getFunction(func)->getFunctionName());
+  chunk.append("\";\n");
+  for (uint32_t line = compact.getFunctionFirstLine(func); line < compact.getFunctionEndLine(func); ++line) {
+    unsigned lineNo = compact.getLine(line)->getLineNumber(graphVersion);
+    for (uint32_t inst = compact.getLineFirstInstruction(line); inst < compact.getLineEndInstruction(line); ++inst) {
+      chunk.append("\t\t\"");
+      Graph_Writer::appendUnsigned(chunk, compact.getInstructionID(inst));
+      chunk.append("\" [label=\"");
+      Graph_Writer::appendUnsigned(chunk, lineNo);
+      chunk.append("::");
+      Graph_Writer::appendEscaped(chunk, compact.getInstruction(inst)->getInstructionLabel());
+      chunk.append("\"];\n");
+    } // End loop for inst
+  }   // End loop for line
+  chunk.append("\t}\n");
+} // End printFunctionChunk
+
+void Graph::printEdgesChunk(const Graph_Compact &compact, uint32_t firstEdge, uint32_t lastEdge, std::string &chunk) {
+  for (uint32_t edgeIndex = firstEdge; edgeIndex < lastEdge; ++edgeIndex) {
+    const char *style = NULL;
+    const char *typeName = NULL;
+    switch (compact.getEdgeType(edgeIndex)) {
     case Graph_Edge::SEQUENTIAL:
-      outputString += "\" [arrowhead = normal, penwidth = 1.0, color = black, label=\"" +
-                      edge->getPrintableEdgeVersions() + "\"];\n";
+      style = "arrowhead = normal, penwidth = 1.0, color = black";
+      typeName = "";
       break;
     case Graph_Edge::BRANCH:
-      outputString += "\" [arrowhead = dot, penwidth = 1.0, color = black, label=\"" +
-                      edge->getPrintableEdgeVersions() + "::Branch\"];\n";
+      style = "arrowhead = dot, penwidth = 1.0, color = black";
+      typeName = "::Branch";
       break;
     case Graph_Edge::VIRTUAL:
-      outputString += "\" [arrowhead = normal, penwidth = 1.0, color = pink, label=\"" +
-                      edge->getPrintableEdgeVersions() + "::Virtual\"];\n";
+      style = "arrowhead = normal, penwidth = 1.0, color = pink";
+      typeName = "::Virtual";
       break;
     case Graph_Edge::CALL:
-      outputString += "\" [arrowhead = odot, penwidth = 1.0, color = blue, label=\"" +
-                      edge->getPrintableEdgeVersions() + "::Call\"];\n";
+      style = "arrowhead = odot, penwidth = 1.0, color = blue";
+      typeName = "::Call";
       break;
     case Graph_Edge::EXTERNAL_CALL:
-      outputString += "\" [arrowhead = odot, penwidth = 1.0, color = yellow, label=\"" +
-                      edge->getPrintableEdgeVersions() + "::External_Call\"];\n";
+      style = "arrowhead = odot, penwidth = 1.0, color = yellow";
+      typeName = "::External_Call";
       break;
     case Graph_Edge::MVICFG_ADD:
-      outputString += "\" [arrowhead = normal, penwidth = 1.0, color = green, label=\"" +
-                      edge->getPrintableEdgeVersions() + "::Add\"];\n";
+      style = "arrowhead = normal, penwidth = 1.0, color = green";
+      typeName = "::Add";
       break;
     case Graph_Edge::MVICFG_DEL:
-      outputString += "\" [arrowhead = normal, penwidth = 1.0, color = red, label=\"" +
-                      edge->getPrintableEdgeVersions() + "::Del\"];\n";
+      style = "arrowhead = normal, penwidth = 1.0, color = red";
+      typeName = "::Del";
       break;
     case Graph_Edge::ANY:
       std::cerr << "Should not have ANY as edgeType\n";
-      outputString += "\" [arrowhead = normal, penwidth = 2.0, color = red, label=\"" +
-                      edge->getPrintableEdgeVersions() + "::ANY\"];\n";
+      style = "arrowhead = normal, penwidth = 2.0, color = red";
+      typeName = "::ANY";
       break;
     } // End switch for edge
-    gFile << outputString;
-  } // End loop for edge
-  /* Finalizing graph */
-  gFile << "}\n";
-  gFile.close();
-} // End printGraph
+    chunk.append("\t\t\"");
+    Graph_Writer::appendUnsigned(chunk, compact.getInstructionID(compact.getEdgeFrom(edgeIndex)));
+    chunk.append("\" -> \"");
+    Graph_Writer::appendUnsigned(chunk, compact.getInstructionID(compact.getEdgeTo(edgeIndex)));
+    chunk.append("\" [");
+    chunk.append(style);
+    chunk.append(", label=\"");
+    bool firstVersion = true;
+    for (auto ver : compact.getEdge(edgeIndex)->getEdgeVersions()) {
+      if (!firstVersion) {
+        chunk.push_back(',');
+      } // End check for firstVersion
+      chunk.push_back('V');
+      Graph_Writer::appendUnsigned(chunk, ver);
+      firstVersion = false;
+    } // End loop for versions
+    chunk.append(typeName);
+    chunk.append("\"];\n");
+  } // End loop for edges
+} // End printEdgesChunk
 
 void getLocationInfo(llvm::Instruction &I, unsigned int &DILocLine, std::string &DIFile) {
   if (llvm::DILocation *DILoc = I.getDebugLoc()) {
@@ -7,6 +7,8 @@
 #define GRAPH_H
 
 /* #include "Graph_Function.hpp" */
+#include "Graph_Arena.hpp"
+#include "Graph_Writer.hpp"
 #include <fstream>
 #include <iostream>
 #include <list>
@@ -14,9 +16,12 @@
 #include <llvm/IR/DebugInfoMetadata.h>
 #include <llvm/IR/InstrTypes.h>
 #include <llvm/IR/Intrinsics.h>
-#include <regex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 namespace hydrogen_framework {
 /* Forward declaration */
+class Graph_Compact;
 class Graph_Edge;
 class Graph_Function;
 class Graph_Instruction;
@@ -27,6 +32,36 @@ class Graph_Line;
  */
 class Graph {
 public:
+  /**
+   * Key for graphLineMap made of interned file name, graph version and line number
+   */
+  typedef struct lineKey {
+    unsigned fileID;  /**< Interned ID of the file name */
+    unsigned version; /**< Graph version */
+    unsigned lineNo;  /**< Line number in the graph version */
+    /**
+     * Overriding equal operation
+     */
+    bool operator==(const lineKey &other) const {
+      return (this->fileID == other.fileID && this->version == other.version && this->lineNo == other.lineNo);
+    }
+  } lineKey;
+
+  /**
+   * Hash functor for lineKey
+   */
+  struct lineKeyHash {
+    /**
+     * Combine the fields of lineKey into a single hash
+     */
+    size_t operator()(const lineKey &key) const {
+      size_t hash = std::hash<unsigned>()(key.fileID);
+      hash = hash * 31 + std::hash<unsigned>()(key.version);
+      hash = hash * 31 + std::hash<unsigned>()(key.lineNo);
+      return hash;
+    }
+  };
+
   /**
    * Constructor
    * Initialize ID to zero
@@ -34,52 +69,54 @@ public:
   Graph(unsigned ver)
       : graphID(0), graphVersion(ver), graphEntryID(std::numeric_limits<unsigned int>::max() - 1),
         graphExitID(std::numeric_limits<unsigned int>::max() - 2) {
-    whiteList.push_back("__isoc99_scanf");
-    whiteList.push_back("printf");
-    whiteList.push_back("malloc");
-    whiteList.push_back("strlen");
-    whiteList.push_back("strcpy");
-    whiteList.push_back("strcmp");
-    whiteList.push_back("free");
-    whiteList.push_back("getpwnam");
-    whiteList.push_back("__ctype_b_loc");
-    whiteList.push_back("tolower");
-    whiteList.push_back("setpwent");
-    whiteList.push_back("getpwent");
-    whiteList.push_back("strchr");
-    whiteList.push_back("strcasecmp");
-    whiteList.push_back("perror");
-    whiteList.push_back("toupper");
-    whiteList.push_back("malloc");
-    whiteList.push_back("strlen");
-    whiteList.push_back("strcpy");
-    whiteList.push_back("strcmp");
-    whiteList.push_back("free");
-    whiteList.push_back("getpwnam");
-    whiteList.push_back("__ctype_b_loc");
-    whiteList.push_back("tolower");
-    whiteList.push_back("setpwent");
-    whiteList.push_back("getpwent");
-    whiteList.push_back("strchr");
-    whiteList.push_back("strcasecmp");
-    whiteList.push_back("perror");
-    whiteList.push_back("snprintf");
-    whiteList.push_back("toupper");
+    whiteList.insert("__isoc99_scanf");
+    whiteList.insert("printf");
+    whiteList.insert("malloc");
+    whiteList.insert("strlen");
+    whiteList.insert("strcpy");
+    whiteList.insert("strcmp");
+    whiteList.insert("free");
+    whiteList.insert("getpwnam");
+    whiteList.insert("__ctype_b_loc");
+    whiteList.insert("tolower");
+    whiteList.insert("setpwent");
+    whiteList.insert("getpwent");
+    whiteList.insert("strchr");
+    whiteList.insert("strcasecmp");
+    whiteList.insert("perror");
+    whiteList.insert("toupper");
+    whiteList.insert("snprintf");
   }
 
   /**
    * Destructor
+   * Frees every container created through graphArena
    */
   ~Graph() {
     graphEdges.clear();
     graphFunctions.clear();
   }
 
+  /**
+   * Return graphArena. Containers of this Graph must be created through it
+   */
+  Graph_Arena &getArena() { return graphArena; }
+
   /**
    * Get next ID
    */
   unsigned getNextID() { return ++graphID; }
 
+  /**
+   * Return graphID, the last ID handed out by getNextID
+   */
+  unsigned getGraphID() { return graphID; }
+
+  /**
+   * Set graphID. Only used when restoring a Graph
+   */
+  void setGraphID(unsigned ID) { graphID = ID; }
+
   /**
    * Return graphVersion
    */
@@ -100,6 +137,46 @@ public:
    */
   void pushGraphFunction(Graph_Function *func);
 
+  /**
+   * Register the Graph_Instructions of a Graph_Line into instructionMap and its line numbers into graphLineMap
+   * Called whenever a Graph_Line becomes reachable from this Graph
+   */
+  void indexGraphLine(Graph_Line *line);
+
+  /**
+   * Register the line number of a Graph_Line for the given version into graphLineMap
+   */
+  void indexLineNumber(Graph_Line *line, unsigned version, unsigned lineNo);
+
+  /**
+   * Register a version of a Graph_Edge of this Graph into versionEdges
+   */
+  void indexEdgeVersion(Graph_Edge *edge, unsigned version);
+
+  /**
+   * Return the Graph_Edges that are part of the given version, in the order in which they joined it
+   * Returns empty container if the version has no Graph_Edge
+   */
+  const std::vector<Graph_Edge *> &getVersionEdges(unsigned version) const;
+
+  /**
+   * Return the Graph_Lines having a non zero line number for the given version, in the order in which they got it
+   * Returns empty container if the version has no Graph_Line
+   */
+  const std::vector<Graph_Line *> &getVersionLines(unsigned version) const;
+
+  /**
+   * Return the Graph_Lines from fileName having lineNo as their line number for the given version
+   * Graph_Lines are in the order in which they were registered
+   * Returns empty container if no Graph_Line is found
+   */
+  const std::vector<Graph_Line *> &getGraphLines(std::string fileName, unsigned version, unsigned lineNo);
+
+  /**
+   * Return the interned ID of the given file name
+   */
+  unsigned getFileID(std::string fileName);
+
   /**
    * Add sequential edges for the instructions in a Graph_Line
    */
@@ -112,6 +189,7 @@ public:
 
   /**
    * Add virtual nodes and corresponding edges to the Graph_Function
+   * The nodes are registered into virtualNodeMap under the function name, unless a function of that name has them
    */
   void addVirtualNodes(Graph_Function *func);
 
@@ -123,6 +201,7 @@ public:
 
   /**
    * Function to add Graph_Edge to both graphEdges and corresponding Graph_Instruction
+   * The versions of the Graph_Edge are registered into versionEdges
    */
   void addEdge(Graph_Instruction *from, Graph_Instruction *to, Graph_Edge *edge);
 
@@ -132,19 +211,42 @@ public:
   void printGraph(std::string graphName);
 
   /**
-   * Find matching instruction in the ICFG
+   * Print the graph in DOT format with the given compression
+   * Functions and edges are formatted in chunks on the given number of threads and written in order
+   * Returns FALSE if the output cannot be written
+   */
+  bool printGraph(std::string graphName, Graph_Writer::writerCompression compression, unsigned threads);
+
+  /**
+   * Find matching instruction in the ICFG using instructionMap
    * Can return NULL if no match is found
    */
   Graph_Instruction *findMatchedInstruction(llvm::Instruction *matchInst);
 
   /**
-   * Find virtual entry for the given function name
+   * Detach every Graph_Instruction in graphArena from its LLVM Instruction and clear instructionMap
+   * Labels are printed before the LLVM Instruction is dropped
+   * Must be called before the LLVM Module of those instructions is freed
+   */
+  void detachInstructions();
+
+  /**
+   * Detach the Graph_Instructions of the given Graph_Lines from their LLVM Instruction and drop them from
+   * instructionMap. Labels are printed before the LLVM Instruction is dropped
+   * Enough when no other Graph_Instruction refers to the LLVM Module about to be freed
+   */
+  void detachInstructions(const std::list<Graph_Line *> &lines);
+
+  /**
+   * Find virtual entry for the given function name using virtualNodeMap
+   * Only virtual nodes added by addVirtualNodes are found
    * Can return NULL if no match is found
    */
   Graph_Instruction *findVirtualEntry(std::string funcName);
 
   /**
-   * Find virtual entry for the given function name
+   * Find virtual exit for the given function name using virtualNodeMap
+   * Only virtual nodes added by addVirtualNodes are found
    * Can return NULL if no match is found
    */
   Graph_Instruction *findVirtualExit(std::string funcName);
@@ -152,7 +254,7 @@ public:
   /**
    * Return graphFunctions
    */
-  std::list<Graph_Function *> getGraphFunctions() { return graphFunctions; }
+  const std::list<Graph_Function *> &getGraphFunctions() const { return graphFunctions; }
 
   /**
    * Return TRUE if it is a virtual node
@@ -162,22 +264,45 @@ public:
   /**
    * Return graphEdges
    */
-  std::list<Graph_Edge *> getGraphEdges() { return graphEdges; }
+  const std::vector<Graph_Edge *> &getGraphEdges() const { return graphEdges; }
 
   /**
    * Return whiteList
    */
-  std::list<std::string> getWhiteList() { return whiteList; }
+  const std::unordered_set<std::string> &getWhiteList() const { return whiteList; }
 
 private:
+  /**
+   * Append the DOT nodes of the function at the given index of compact to chunk
+   */
+  void printFunctionChunk(const Graph_Compact &compact, uint32_t func, std::string &chunk);
+
+  /**
+   * Append the DOT edges in [firstEdge, lastEdge) of compact to chunk
+   */
+  void printEdgesChunk(const Graph_Compact &compact, uint32_t firstEdge, uint32_t lastEdge, std::string &chunk);
+
+  static const unsigned printWindow = 64;      /**< Chunks formatted per thread before they are written */
+  static const uint32_t printEdgeChunk = 4096; /**< Edges per chunk */
+
   unsigned graphID;                           /**< Unique Graph ID */
   unsigned graphVersion;                      /**< Version of graph. */
   unsigned graphEntryID;                      /**< ID for all virtual entry Node. Set to max -1 */
   unsigned graphExitID;                       /**< ID for all virtual exit Node. Set to max -2 */
-  std::list<Graph_Edge *> graphEdges;         /**< Container for Edges in the graph */
+  Graph_Arena graphArena;                     /**< Owns the containers of the graph. Destroyed last */
+  std::vector<Graph_Edge *> graphEdges;       /**< Container for Edges in the graph */
   std::list<Graph_Function *> graphFunctions; /**< Container for function containers */
-  std::list<std::string> whiteList;           /**< Container for white-listed functions */
-};                                            // End Graph Class
+  std::unordered_set<std::string> whiteList;  /**< Container for white-listed functions */
+  std::unordered_map<llvm::Instruction *, Graph_Instruction *>
+      instructionMap; /**< Map from LLVM Instruction to the Graph_Instruction holding it */
+  std::unordered_map<std::string, unsigned> fileIDs; /**< Interned IDs of the file names */
+  std::unordered_map<std::string, std::pair<Graph_Instruction *, Graph_Instruction *>>
+      virtualNodeMap; /**< Map from function name to its virtual entry and exit */
+  std::unordered_map<lineKey, std::vector<Graph_Line *>, lineKeyHash>
+      graphLineMap; /**< Map from (file, version, line number) to Graph_Lines */
+  std::vector<std::vector<Graph_Edge *>> versionEdges; /**< Graph_Edges of every version */
+  std::vector<std::vector<Graph_Line *>> versionLines; /**< Graph_Lines with a line number in every version */
+};                  // End Graph Class
 
 /**
  * Find the line number and file name of the given LLVM instruction
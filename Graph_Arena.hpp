@@ -0,0 +1,179 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Graph_Arena Class: Pool allocation for the containers of a Graph
+ */
+#ifndef GRAPH_ARENA_H
+#define GRAPH_ARENA_H
+
+#include "Graph_Edge.hpp"
+#include "Graph_Function.hpp"
+#include "Graph_Instruction.hpp"
+#include "Graph_Line.hpp"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+namespace hydrogen_framework {
+/**
+ * Arena_Pool Class: Constructs objects of one type in place inside blocks that are never reallocated
+ * Objects stay at the same address till the pool is destroyed, which destroys them in reverse order of creation
+ */
+template <typename T> class Arena_Pool {
+public:
+  /**
+   * Constructor
+   */
+  Arena_Pool() {}
+
+  /**
+   * Destructor
+   */
+  ~Arena_Pool() { releasePool(); }
+
+  /**
+   * Construct a T from args in the current block. A new block is started when it is full
+   */
+  template <typename... Args> T *create(Args &&... args) {
+    if (poolBlocks.empty() || poolBlocks.back().used == poolBlocks.back().capacity) {
+      std::size_t capacity = poolBlocks.empty() ? firstBlock : std::min(poolBlocks.back().capacity * 2, lastBlock);
+      poolBlocks.push_back(poolBlock(capacity));
+    } // End check for full block
+    poolBlock &block = poolBlocks.back();
+    T *obj = new (&block.slots[block.used]) T(std::forward<Args>(args)...);
+    ++block.used;
+    return obj;
+  }
+
+  /**
+   * Take over the blocks of other. Its objects keep their addresses and other is left empty
+   * The current block stays last, so that its free slots are still used
+   */
+  void adoptPool(Arena_Pool &other) {
+    auto insertAt = poolBlocks.empty() ? poolBlocks.end() : std::prev(poolBlocks.end());
+    poolBlocks.insert(insertAt, std::make_move_iterator(other.poolBlocks.begin()),
+                      std::make_move_iterator(other.poolBlocks.end()));
+    other.poolBlocks.clear();
+  }
+
+  /**
+   * Call visit on every object in the pool
+   */
+  template <typename Visitor> void visitPool(Visitor visit) {
+    for (auto &block : poolBlocks) {
+      for (std::size_t slot = 0; slot < block.used; ++slot) {
+        visit(reinterpret_cast<T *>(&block.slots[slot]));
+      } // End loop for slot
+    }   // End loop for block
+  }
+
+  /**
+   * Destroy every object in reverse order of creation and free the blocks
+   */
+  void releasePool() {
+    for (auto block = poolBlocks.rbegin(); block != poolBlocks.rend(); ++block) {
+      for (std::size_t slot = block->used; slot > 0; --slot) {
+        reinterpret_cast<T *>(&block->slots[slot - 1])->~T();
+      } // End loop for slot
+    }   // End loop for block
+    poolBlocks.clear();
+  }
+
+private:
+  /**
+   * Uninitialized storage for one T
+   */
+  typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type poolSlot;
+
+  /**
+   * Block of slots. Only the first used slots hold objects
+   */
+  typedef struct poolBlock {
+    std::unique_ptr<poolSlot[]> slots; /**< Storage for the objects */
+    std::size_t used;                  /**< Number of constructed objects */
+    std::size_t capacity;              /**< Number of slots */
+    /**
+     * Constructor
+     */
+    poolBlock(std::size_t size) : slots(new poolSlot[size]), used(0), capacity(size) {}
+  } poolBlock;
+
+  static const std::size_t firstBlock = 16;  /**< Slots in the first block. Small functions need little */
+  static const std::size_t lastBlock = 4096; /**< Slots in a block stop doubling here */
+  std::vector<poolBlock> poolBlocks;         /**< Blocks in the order they were started */
+};                                           // End Arena_Pool Class
+
+template <typename T> const std::size_t Arena_Pool<T>::firstBlock;
+template <typename T> const std::size_t Arena_Pool<T>::lastBlock;
+
+/**
+ * Graph_Arena Class: Owns every Graph_Function, Graph_Line, Graph_Instruction and Graph_Edge created for a Graph
+ * Everything is freed together when the arena is destroyed, so a merged ICFG costs a single delete
+ * An arena is used by one thread at a time. Workers fill their own arena which is then adopted by the Graph
+ */
+class Graph_Arena {
+public:
+  /**
+   * Constructor
+   */
+  Graph_Arena() {}
+
+  /**
+   * Destructor
+   * Edges go first as they refer to instructions, then instructions, lines and functions
+   */
+  ~Graph_Arena() {
+    arenaEdges.releasePool();
+    arenaInstructions.releasePool();
+    arenaLines.releasePool();
+    arenaFunctions.releasePool();
+  }
+
+  /**
+   * Create Graph_Function with the given ID
+   */
+  Graph_Function *newFunction(unsigned id) { return arenaFunctions.create(id); }
+
+  /**
+   * Create Graph_Line for the given version
+   */
+  Graph_Line *newLine(unsigned version) { return arenaLines.create(version); }
+
+  /**
+   * Create Graph_Instruction
+   */
+  Graph_Instruction *newInstruction() { return arenaInstructions.create(); }
+
+  /**
+   * Create Graph_Edge from the from instruction to the to instruction
+   */
+  Graph_Edge *newEdge(Graph_Instruction *from, Graph_Instruction *to, Graph_Edge::edgeTypes type, unsigned ver) {
+    return arenaEdges.create(from, to, type, ver);
+  }
+
+  /**
+   * Call visit on every Graph_Instruction in the arena, including the ones only reachable from edges
+   */
+  template <typename Visitor> void visitInstructions(Visitor visit) { arenaInstructions.visitPool(visit); }
+
+  /**
+   * Take over everything created in other. Other is left empty
+   */
+  void adoptArena(Graph_Arena &other) {
+    arenaFunctions.adoptPool(other.arenaFunctions);
+    arenaLines.adoptPool(other.arenaLines);
+    arenaInstructions.adoptPool(other.arenaInstructions);
+    arenaEdges.adoptPool(other.arenaEdges);
+  }
+
+private:
+  Arena_Pool<Graph_Function> arenaFunctions;       /**< Pool for Graph_Function */
+  Arena_Pool<Graph_Line> arenaLines;               /**< Pool for Graph_Line */
+  Arena_Pool<Graph_Instruction> arenaInstructions; /**< Pool for Graph_Instruction */
+  Arena_Pool<Graph_Edge> arenaEdges;               /**< Pool for Graph_Edge */
+};                                                 // End Graph_Arena Class
+} // namespace hydrogen_framework
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Implementing Graph_Compact.hpp
+ */
+#include "Graph_Compact.hpp"
+#include "Graph.hpp"
+#include "Graph_Function.hpp"
+#include "Graph_Instruction.hpp"
+#include "Graph_Line.hpp"
+namespace hydrogen_framework {
+const uint32_t Graph_Compact::noIndex;
+
+Graph_Compact::Graph_Compact(Graph *graph) {
+  std::unordered_map<Graph_Instruction *, uint32_t> instructionIndex;
+  /* Functions, lines and instructions */
+  for (auto func : graph->getGraphFunctions()) {
+    uint32_t funcIndex = compactFunctions.size();
+    compactFunctions.push_back(func);
+    functionLineStart.push_back(compactLines.size());
+    for (auto line : func->getFunctionLines()) {
+      uint32_t lineIndex = compactLines.size();
+      compactLines.push_back(line);
+      lineFunction.push_back(funcIndex);
+      lineInstructionStart.push_back(compactInstructions.size());
+      for (auto inst : line->getLineInstructions()) {
+        instructionIndex.insert(std::pair<Graph_Instruction *, uint32_t>(inst, compactInstructions.size()));
+        compactInstructions.push_back(inst);
+        instructionIDs.push_back(inst->getInstructionID());
+        instructionLine.push_back(lineIndex);
+      } // End loop for inst
+    }   // End loop for line
+  }     // End loop for func
+  functionLineStart.push_back(compactLines.size());
+  lineInstructionStart.push_back(compactInstructions.size());
+  /* Edges. Their end points need not be in the Graph functions */
+  const std::vector<Graph_Edge *> &edges = graph->getGraphEdges();
+  auto getIndex = [&](Graph_Instruction *inst) -> uint32_t {
+    auto findInst = instructionIndex.find(inst);
+    if (findInst != instructionIndex.end()) {
+      return findInst->second;
+    } // End check for findInst
+    uint32_t index = compactInstructions.size();
+    instructionIndex.insert(std::pair<Graph_Instruction *, uint32_t>(inst, index));
+    compactInstructions.push_back(inst);
+    instructionIDs.push_back(inst->getInstructionID());
+    instructionLine.push_back(noIndex);
+    return index;
+  };
+  compactEdges.reserve(edges.size());
+  edgeFrom.reserve(edges.size());
+  edgeTo.reserve(edges.size());
+  edgeType.reserve(edges.size());
+  for (auto edge : edges) {
+    compactEdges.push_back(edge);
+    edgeFrom.push_back(getIndex(edge->getEdgeFrom()));
+    edgeTo.push_back(getIndex(edge->getEdgeTo()));
+    edgeType.push_back(edge->getEdgeType());
+  } // End loop for edges
+  /* CSR adjacency by counting sort, which keeps the order of the Graph within every instruction */
+  std::size_t instCount = compactInstructions.size();
+  outEdgeStart.assign(instCount + 1, 0);
+  inEdgeStart.assign(instCount + 1, 0);
+  for (uint32_t edge = 0; edge < compactEdges.size(); ++edge) {
+    ++outEdgeStart[edgeFrom[edge] + 1];
+    ++inEdgeStart[edgeTo[edge] + 1];
+  } // End loop for counting edges
+  for (std::size_t inst = 0; inst < instCount; ++inst) {
+    outEdgeStart[inst + 1] += outEdgeStart[inst];
+    inEdgeStart[inst + 1] += inEdgeStart[inst];
+  } // End loop for offsets
+  outEdges.resize(compactEdges.size());
+  inEdges.resize(compactEdges.size());
+  std::vector<uint32_t> outFill(outEdgeStart.begin(), outEdgeStart.end() - 1);
+  std::vector<uint32_t> inFill(inEdgeStart.begin(), inEdgeStart.end() - 1);
+  for (uint32_t edge = 0; edge < compactEdges.size(); ++edge) {
+    outEdges[outFill[edgeFrom[edge]]++] = edge;
+    inEdges[inFill[edgeTo[edge]]++] = edge;
+  } // End loop for placing edges
+} // End Graph_Compact
+
+Graph_Compact::indexRange Graph_Compact::getOutEdges(uint32_t inst) const {
+  indexRange range;
+  range.first = outEdges.data() + outEdgeStart[inst];
+  range.last = outEdges.data() + outEdgeStart[inst + 1];
+  return range;
+} // End getOutEdges
+
+Graph_Compact::indexRange Graph_Compact::getInEdges(uint32_t inst) const {
+  indexRange range;
+  range.first = inEdges.data() + inEdgeStart[inst];
+  range.last = inEdges.data() + inEdgeStart[inst + 1];
+  return range;
+} // End getInEdges
+} // namespace hydrogen_framework
@@ -0,0 +1,184 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Graph_Compact Class: Frozen compact view of a Graph
+ */
+#ifndef GRAPH_COMPACT_H
+#define GRAPH_COMPACT_H
+
+#include "Graph_Edge.hpp"
+#include <cstdint>
+#include <vector>
+namespace hydrogen_framework {
+/* Forward declaration */
+class Graph;
+class Graph_Function;
+class Graph_Instruction;
+class Graph_Line;
+
+/**
+ * Graph_Compact Class: Functions, lines, instructions and edges of a Graph in contiguous arrays
+ * Everything is addressed by 32 bit indices and the edges of each instruction are kept in CSR form
+ * The view is built once and does not follow later changes to the Graph
+ */
+class Graph_Compact {
+public:
+  /**
+   * Range of indices into one of the index arrays. Usable in range based for loops
+   */
+  typedef struct indexRange {
+    const uint32_t *first; /**< First index */
+    const uint32_t *last;  /**< One past the last index */
+    /**
+     * Return first
+     */
+    const uint32_t *begin() const { return first; }
+    /**
+     * Return last
+     */
+    const uint32_t *end() const { return last; }
+    /**
+     * Return number of indices
+     */
+    uint32_t size() const { return last - first; }
+  } indexRange;
+
+  /**
+   * Index of instructions that are reachable only from edges and have no line in the Graph
+   */
+  static const uint32_t noIndex = 0xffffffff;
+
+  /**
+   * Constructor
+   * Builds the view of the given Graph
+   */
+  Graph_Compact(Graph *graph);
+
+  /**
+   * Destructor
+   */
+  ~Graph_Compact() {}
+
+  /**
+   * Return number of functions
+   */
+  uint32_t getFunctionCount() const { return compactFunctions.size(); }
+
+  /**
+   * Return number of lines
+   */
+  uint32_t getLineCount() const { return compactLines.size(); }
+
+  /**
+   * Return number of instructions, including the ones only reachable from edges
+   */
+  uint32_t getInstructionCount() const { return compactInstructions.size(); }
+
+  /**
+   * Return number of edges
+   */
+  uint32_t getEdgeCount() const { return compactEdges.size(); }
+
+  /**
+   * Return the Graph_Function at the given index
+   */
+  Graph_Function *getFunction(uint32_t func) const { return compactFunctions[func]; }
+
+  /**
+   * Return the index of the first line in the given function
+   */
+  uint32_t getFunctionFirstLine(uint32_t func) const { return functionLineStart[func]; }
+
+  /**
+   * Return one past the index of the last line in the given function
+   */
+  uint32_t getFunctionEndLine(uint32_t func) const { return functionLineStart[func + 1]; }
+
+  /**
+   * Return the Graph_Line at the given index
+   */
+  Graph_Line *getLine(uint32_t line) const { return compactLines[line]; }
+
+  /**
+   * Return the index of the function of the given line
+   */
+  uint32_t getLineFunction(uint32_t line) const { return lineFunction[line]; }
+
+  /**
+   * Return the index of the first instruction in the given line
+   */
+  uint32_t getLineFirstInstruction(uint32_t line) const { return lineInstructionStart[line]; }
+
+  /**
+   * Return one past the index of the last instruction in the given line
+   */
+  uint32_t getLineEndInstruction(uint32_t line) const { return lineInstructionStart[line + 1]; }
+
+  /**
+   * Return the Graph_Instruction at the given index
+   */
+  Graph_Instruction *getInstruction(uint32_t inst) const { return compactInstructions[inst]; }
+
+  /**
+   * Return the ID of the instruction at the given index
+   */
+  unsigned getInstructionID(uint32_t inst) const { return instructionIDs[inst]; }
+
+  /**
+   * Return the index of the line of the given instruction
+   * Returns noIndex for instructions that are reachable only from edges
+   */
+  uint32_t getInstructionLine(uint32_t inst) const { return instructionLine[inst]; }
+
+  /**
+   * Return the Graph_Edge at the given index
+   */
+  Graph_Edge *getEdge(uint32_t edge) const { return compactEdges[edge]; }
+
+  /**
+   * Return the index of the from instruction of the given edge
+   */
+  uint32_t getEdgeFrom(uint32_t edge) const { return edgeFrom[edge]; }
+
+  /**
+   * Return the index of the to instruction of the given edge
+   */
+  uint32_t getEdgeTo(uint32_t edge) const { return edgeTo[edge]; }
+
+  /**
+   * Return the type of the given edge
+   */
+  Graph_Edge::edgeTypes getEdgeType(uint32_t edge) const {
+    return static_cast<Graph_Edge::edgeTypes>(edgeType[edge]);
+  }
+
+  /**
+   * Return the indices of the edges leaving the given instruction in the order of the Graph
+   */
+  indexRange getOutEdges(uint32_t inst) const;
+
+  /**
+   * Return the indices of the edges entering the given instruction in the order of the Graph
+   */
+  indexRange getInEdges(uint32_t inst) const;
+
+private:
+  std::vector<Graph_Function *> compactFunctions;       /**< Functions in the order of the Graph */
+  std::vector<uint32_t> functionLineStart;              /**< First line of every function and the line count */
+  std::vector<Graph_Line *> compactLines;               /**< Lines grouped by function */
+  std::vector<uint32_t> lineFunction;                   /**< Function of every line */
+  std::vector<uint32_t> lineInstructionStart;           /**< First instruction of every line and the count */
+  std::vector<Graph_Instruction *> compactInstructions; /**< Instructions grouped by line */
+  std::vector<unsigned> instructionIDs;                 /**< ID of every instruction */
+  std::vector<uint32_t> instructionLine;                /**< Line of every instruction */
+  std::vector<Graph_Edge *> compactEdges;               /**< Edges in the order of the Graph */
+  std::vector<uint32_t> edgeFrom;                       /**< From instruction of every edge */
+  std::vector<uint32_t> edgeTo;                         /**< To instruction of every edge */
+  std::vector<uint8_t> edgeType;                        /**< Type of every edge */
+  std::vector<uint32_t> outEdgeStart;                   /**< CSR offsets into outEdges for every instruction */
+  std::vector<uint32_t> outEdges;                       /**< Edges grouped by from instruction */
+  std::vector<uint32_t> inEdgeStart;                    /**< CSR offsets into inEdges for every instruction */
+  std::vector<uint32_t> inEdges;                        /**< Edges grouped by to instruction */
+};                                                      // End Graph_Compact Class
+} // namespace hydrogen_framework
+#endif
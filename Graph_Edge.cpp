@@ -4,23 +4,39 @@
  * Implementing Graph_Edge.hpp
  */
 #include "Graph_Edge.hpp"
+#include "Graph.hpp"
 #include "Graph_Instruction.hpp"
 namespace hydrogen_framework {
+void Graph_Edge::pushEdgeVersions(unsigned ver) {
+  /* Keep the version index of the encompassing Graph up to date */
+  if (edgeVersions.insert(ver) && edgeGraph) {
+    edgeGraph->indexEdgeVersion(this, ver);
+  } // End check for new version
+} // End pushEdgeVersions
+
 std::string Graph_Edge::getPrintableEdgeVersions() {
-  std::string ver;
-  for (auto v : edgeVersions) {
-    ver = ver + "V" + std::to_string(v) + ",";
-  } // End loop for edgveVersions
-  ver.pop_back();
-  return ver;
+  return edgeVersions.getPrintableVersions();
 } // End getPrintableEdgeVersions
 
-bool Graph_Edge::isPartOfGraph(unsigned graphVersion) {
-  auto findVer = std::find_if(std::begin(edgeVersions), std::end(edgeVersions),
-                              [=](unsigned ver) { return (ver == graphVersion); });
-  if (findVer != edgeVersions.end()) {
-    return true;
-  } // End loop for edgeVersions
-  return false;
-} // End isPartOfGraph
+const char *Graph_Edge::getEdgeTypeName(edgeTypes type) {
+  switch (type) {
+  case SEQUENTIAL:
+    return "Sequential";
+  case BRANCH:
+    return "Branch";
+  case CALL:
+    return "Call";
+  case EXTERNAL_CALL:
+    return "External_Call";
+  case VIRTUAL:
+    return "Virtual";
+  case MVICFG_ADD:
+    return "Add";
+  case MVICFG_DEL:
+    return "Del";
+  case ANY:
+    return "ANY";
+  } // End switch for type
+  return "ANY";
+} // End getEdgeTypeName
 } // namespace hydrogen_framework
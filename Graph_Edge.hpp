@@ -6,10 +6,11 @@
 #ifndef GRAPH_EDGE_H
 #define GRAPH_EDGE_H
 
-#include <list>
+#include "Graph_Versions.hpp"
 #include <string>
 namespace hydrogen_framework {
 /* Forward Declaration */
+class Graph;
 class Graph_Instruction;
 
 /**
@@ -20,7 +21,7 @@ public:
   /**
    * Constructor
    */
-  Graph_Edge() : edgeFrom(NULL), edgeTo(NULL), edgeType(edgeTypes::ANY) {}
+  Graph_Edge() : edgeFrom(NULL), edgeTo(NULL), edgeType(edgeTypes::ANY), edgeGraph(NULL) {}
 
   /**
    * Enumeration for type of edges
@@ -31,14 +32,14 @@ public:
    * Alternate constructor
    */
   Graph_Edge(Graph_Instruction *from, Graph_Instruction *to, edgeTypes type, unsigned ver)
-      : edgeFrom(from), edgeTo(to), edgeType(type) {
-    edgeVersions.push_back(ver);
+      : edgeFrom(from), edgeTo(to), edgeType(type), edgeGraph(NULL) {
+    edgeVersions.insert(ver);
   }
 
   /**
    * Destructor
    */
-  ~Graph_Edge() { edgeVersions.clear(); }
+  ~Graph_Edge() {}
 
   /**
    * Set edgeFrom
@@ -56,9 +57,20 @@ public:
   void setEdgeType(edgeTypes type) { edgeType = type; }
 
   /**
-   * Push version to back of edgeVersions
+   * Add version to edgeVersions. Versions already present are not added again
+   * New versions are registered with the encompassing Graph
    */
-  void pushEdgeVersions(int ver) { edgeVersions.push_back(ver); }
+  void pushEdgeVersions(unsigned ver);
+
+  /**
+   * Set pointer to encompassing Graph
+   */
+  void setEdgeGraph(Graph *graph) { edgeGraph = graph; }
+
+  /**
+   * Return pointer to encompassing Graph
+   */
+  Graph *getEdgeGraph() { return edgeGraph; }
 
   /**
    * Return edgeFrom
@@ -78,24 +90,30 @@ public:
   /**
    * Return edgeVersions
    */
-  std::list<unsigned> getEdgeVersions() { return edgeVersions; }
+  const Graph_Versions &getEdgeVersions() const { return edgeVersions; }
 
   /**
    * Get printable edgeVersions
    */
   std::string getPrintableEdgeVersions();
 
+  /**
+   * Return the name of the given edge type as used in the DOT labels
+   */
+  static const char *getEdgeTypeName(edgeTypes type);
+
   /**
    * Check if the edge is already part of a given graph Version
    * Return TRUE only if the given graphVersion is contained in edgeVersions
    */
-  bool isPartOfGraph(unsigned graphVersion);
+  bool isPartOfGraph(unsigned graphVersion) const { return edgeVersions.contains(graphVersion); }
 
 private:
-  Graph_Instruction *edgeFrom;      /**< From Instruction */
-  Graph_Instruction *edgeTo;        /**< To Instruction */
-  edgeTypes edgeType;               /**< Edge Type */
-  std::list<unsigned> edgeVersions; /**< Container to store edge's versions */
-};                                  // End Graph_Edge Class
+  Graph_Instruction *edgeFrom; /**< From Instruction */
+  Graph_Instruction *edgeTo;   /**< To Instruction */
+  edgeTypes edgeType;          /**< Edge Type */
+  Graph_Versions edgeVersions; /**< Set of edge's versions */
+  Graph *edgeGraph;            /**< Points to the Graph that encompasses this */
+};                             // End Graph_Edge Class
 } // namespace hydrogen_framework
 #endif
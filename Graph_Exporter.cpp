@@ -0,0 +1,325 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Implementing Graph_Exporter.hpp
+ */
+#include "Graph_Exporter.hpp"
+#include "Graph.hpp"
+#include "Graph_Compact.hpp"
+#include "Graph_Edge.hpp"
+#include "Graph_Function.hpp"
+#include "Graph_Instruction.hpp"
+#include "Graph_Line.hpp"
+#include <unordered_map>
+namespace hydrogen_framework {
+bool Graph_Exporter::parseFormat(std::string name, exporterFormat &format) {
+  if (name == "dot") {
+    format = DOT;
+  } else if (name == "graphml") {
+    format = GRAPHML;
+  } else if (name == "jsonl") {
+    format = JSONL;
+  } else if (name == "edgelist") {
+    format = EDGELIST;
+  } else {
+    return false;
+  } // End check for name
+  return true;
+} // End parseFormat
+
+Graph_Exporter *Graph_Exporter::createExporter(exporterFormat format) {
+  switch (format) {
+  case DOT:
+    return NULL;
+  case GRAPHML:
+    return new GraphML_Exporter();
+  case JSONL:
+    return new JSONL_Exporter();
+  case EDGELIST:
+    return new EdgeList_Exporter();
+  } // End switch for format
+  return NULL;
+} // End createExporter
+
+void GraphML_Exporter::appendXMLEscaped(std::string &out, const std::string &text) {
+  for (auto c : text) {
+    switch (c) {
+    case '&':
+      out.append("&amp;");
+      break;
+    case '<':
+      out.append("&lt;");
+      break;
+    case '>':
+      out.append("&gt;");
+      break;
+    case '"':
+      out.append("&quot;");
+      break;
+    default:
+      out.push_back(c);
+    } // End switch for c
+  }   // End loop for text
+} // End appendXMLEscaped
+
+void GraphML_Exporter::exportGraph(Graph *graph, const Graph_Compact &compact, Graph_Writer &writer) {
+  std::string record;
+  record.append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+  record.append("<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n");
+  record.append("  <key id=\"id\" for=\"node\" attr.name=\"instruction\" attr.type=\"long\"/>\n");
+  record.append("  <key id=\"label\" for=\"node\" attr.name=\"label\" attr.type=\"string\"/>\n");
+  record.append("  <key id=\"function\" for=\"node\" attr.name=\"function\" attr.type=\"string\"/>\n");
+  record.append("  <key id=\"file\" for=\"node\" attr.name=\"file\" attr.type=\"string\"/>\n");
+  record.append("  <key id=\"lines\" for=\"node\" attr.name=\"lines\" attr.type=\"string\"/>\n");
+  record.append("  <key id=\"type\" for=\"edge\" attr.name=\"type\" attr.type=\"string\"/>\n");
+  record.append("  <key id=\"versions\" for=\"edge\" attr.name=\"versions\" attr.type=\"string\"/>\n");
+  record.append("  <key id=\"count\" for=\"graph\" attr.name=\"versions\" attr.type=\"long\"/>\n");
+  record.append("  <graph id=\"MVICFG\" edgedefault=\"directed\">\n");
+  record.append("    <data key=\"count\">");
+  Graph_Writer::appendUnsigned(record, graph->getGraphVersion());
+  record.append("</data>\n");
+  writer.write(record);
+  /* Nodes */
+  for (uint32_t inst = 0; inst < compact.getInstructionCount(); ++inst) {
+    record.clear();
+    record.append("    <node id=\"n");
+    Graph_Writer::appendUnsigned(record, inst);
+    record.append("\">\n      <data key=\"id\">");
+    Graph_Writer::appendUnsigned(record, compact.getInstructionID(inst));
+    record.append("</data>\n      <data key=\"label\">");
+    appendXMLEscaped(record, compact.getInstruction(inst)->getInstructionLabel());
+    record.append("</data>\n");
+    uint32_t line = compact.getInstructionLine(inst);
+    if (line != Graph_Compact::noIndex) {
+      Graph_Function *func = compact.getFunction(compact.getLineFunction(line));
+      record.append("      <data key=\"function\">");
+      appendXMLEscaped(record, func->getFunctionName());
+      record.append("</data>\n      <data key=\"file\">");
+      appendXMLEscaped(record, func->getFunctionFile());
+      record.append("</data>\n      <data key=\"lines\">");
+      bool firstVersion = true;
+      for (auto ver : compact.getLine(line)->getLineVersions()) {
+        if (!firstVersion) {
+          record.push_back(',');
+        } // End check for firstVersion
+        Graph_Writer::appendUnsigned(record, ver);
+        record.push_back(':');
+        Graph_Writer::appendUnsigned(record, compact.getLine(line)->getLineNumber(ver));
+        firstVersion = false;
+      } // End loop for versions
+      record.append("</data>\n");
+    } // End check for line
+    record.append("    </node>\n");
+    writer.write(record);
+  } // End loop for nodes
+  /* Edges */
+  for (uint32_t edge = 0; edge < compact.getEdgeCount(); ++edge) {
+    record.clear();
+    record.append("    <edge source=\"n");
+    Graph_Writer::appendUnsigned(record, compact.getEdgeFrom(edge));
+    record.append("\" target=\"n");
+    Graph_Writer::appendUnsigned(record, compact.getEdgeTo(edge));
+    record.append("\">\n      <data key=\"type\">");
+    record.append(Graph_Edge::getEdgeTypeName(compact.getEdgeType(edge)));
+    record.append("</data>\n      <data key=\"versions\">");
+    bool firstVersion = true;
+    for (auto ver : compact.getEdge(edge)->getEdgeVersions()) {
+      if (!firstVersion) {
+        record.push_back(',');
+      } // End check for firstVersion
+      Graph_Writer::appendUnsigned(record, ver);
+      firstVersion = false;
+    } // End loop for versions
+    record.append("</data>\n    </edge>\n");
+    writer.write(record);
+  } // End loop for edges
+  writer.write("  </graph>\n</graphml>\n");
+} // End exportGraph
+
+void JSONL_Exporter::appendJSONString(std::string &out, const std::string &text) {
+  static const char hexDigits[] = "0123456789abcdef";
+  out.push_back('"');
+  for (auto c : text) {
+    switch (c) {
+    case '"':
+      out.append("\\\"");
+      break;
+    case '\\':
+      out.append("\\\\");
+      break;
+    case '\n':
+      out.append("\\n");
+      break;
+    case '\t':
+      out.append("\\t");
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        out.append("\\u00");
+        out.push_back(hexDigits[c >> 4]);
+        out.push_back(hexDigits[c & 0xf]);
+      } else {
+        out.push_back(c);
+      } // End check for control character
+    }   // End switch for c
+  }     // End loop for text
+  out.push_back('"');
+} // End appendJSONString
+
+void JSONL_Exporter::exportGraph(Graph *graph, const Graph_Compact &compact, Graph_Writer &writer) {
+  std::string record;
+  record.append("{\"record\":\"graph\",\"versions\":");
+  Graph_Writer::appendUnsigned(record, graph->getGraphVersion());
+  record.append(",\"nodes\":");
+  Graph_Writer::appendUnsigned(record, compact.getInstructionCount());
+  record.append(",\"edges\":");
+  Graph_Writer::appendUnsigned(record, compact.getEdgeCount());
+  record.append("}\n");
+  writer.write(record);
+  /* Nodes */
+  for (uint32_t inst = 0; inst < compact.getInstructionCount(); ++inst) {
+    record.clear();
+    record.append("{\"record\":\"node\",\"id\":");
+    Graph_Writer::appendUnsigned(record, inst);
+    record.append(",\"instruction\":");
+    Graph_Writer::appendUnsigned(record, compact.getInstructionID(inst));
+    record.append(",\"label\":");
+    appendJSONString(record, compact.getInstruction(inst)->getInstructionLabel());
+    uint32_t line = compact.getInstructionLine(inst);
+    if (line != Graph_Compact::noIndex) {
+      Graph_Function *func = compact.getFunction(compact.getLineFunction(line));
+      record.append(",\"function\":");
+      appendJSONString(record, func->getFunctionName());
+      record.append(",\"file\":");
+      appendJSONString(record, func->getFunctionFile());
+      record.append(",\"lines\":{");
+      bool firstVersion = true;
+      for (auto ver : compact.getLine(line)->getLineVersions()) {
+        if (!firstVersion) {
+          record.push_back(',');
+        } // End check for firstVersion
+        record.push_back('"');
+        Graph_Writer::appendUnsigned(record, ver);
+        record.append("\":");
+        Graph_Writer::appendUnsigned(record, compact.getLine(line)->getLineNumber(ver));
+        firstVersion = false;
+      } // End loop for versions
+      record.push_back('}');
+    } // End check for line
+    record.append("}\n");
+    writer.write(record);
+  } // End loop for nodes
+  /* Edges */
+  for (uint32_t edge = 0; edge < compact.getEdgeCount(); ++edge) {
+    record.clear();
+    record.append("{\"record\":\"edge\",\"from\":");
+    Graph_Writer::appendUnsigned(record, compact.getEdgeFrom(edge));
+    record.append(",\"to\":");
+    Graph_Writer::appendUnsigned(record, compact.getEdgeTo(edge));
+    record.append(",\"type\":\"");
+    record.append(Graph_Edge::getEdgeTypeName(compact.getEdgeType(edge)));
+    record.append("\",\"versions\":[");
+    bool firstVersion = true;
+    for (auto ver : compact.getEdge(edge)->getEdgeVersions()) {
+      if (!firstVersion) {
+        record.push_back(',');
+      } // End check for firstVersion
+      Graph_Writer::appendUnsigned(record, ver);
+      firstVersion = false;
+    } // End loop for versions
+    record.append("]}\n");
+    writer.write(record);
+  } // End loop for edges
+} // End exportGraph
+
+void EdgeList_Exporter::exportGraph(Graph *graph, const Graph_Compact &compact, Graph_Writer &writer) {
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, uint32_t> stringIndex;
+  auto internString = [&](std::string text) -> uint32_t {
+    auto found = stringIndex.find(text);
+    if (found != stringIndex.end()) {
+      return found->second;
+    } // End check for found
+    stringIndex[text] = strings.size();
+    strings.push_back(text);
+    return strings.size() - 1;
+  };
+  /* Functions */
+  std::vector<edgeListFunction> functions(compact.getFunctionCount());
+  for (uint32_t func = 0; func < compact.getFunctionCount(); ++func) {
+    functions[func].name = internString(compact.getFunction(func)->getFunctionName());
+    functions[func].file = internString(compact.getFunction(func)->getFunctionFile());
+  } // End loop for functions
+  /* Nodes */
+  std::vector<edgeListNode> nodes(compact.getInstructionCount());
+  std::vector<edgeListLineNumber> lineNumbers;
+  for (uint32_t inst = 0; inst < compact.getInstructionCount(); ++inst) {
+    uint32_t line = compact.getInstructionLine(inst);
+    nodes[inst].instructionID = compact.getInstructionID(inst);
+    nodes[inst].function = line == Graph_Compact::noIndex ? Graph_Compact::noIndex : compact.getLineFunction(line);
+    nodes[inst].firstLineNumber = lineNumbers.size();
+    if (line != Graph_Compact::noIndex) {
+      for (auto ver : compact.getLine(line)->getLineVersions()) {
+        edgeListLineNumber lineNumber = {ver, compact.getLine(line)->getLineNumber(ver)};
+        lineNumbers.push_back(lineNumber);
+      } // End loop for versions
+    }   // End check for line
+    nodes[inst].lineNumberCount = lineNumbers.size() - nodes[inst].firstLineNumber;
+  } // End loop for nodes
+  /* Edges */
+  std::vector<edgeListEdge> edges(compact.getEdgeCount());
+  std::vector<uint32_t> edgeVersions;
+  for (uint32_t edge = 0; edge < compact.getEdgeCount(); ++edge) {
+    edges[edge].from = compact.getEdgeFrom(edge);
+    edges[edge].to = compact.getEdgeTo(edge);
+    edges[edge].type = compact.getEdgeType(edge);
+    edges[edge].firstVersion = edgeVersions.size();
+    for (auto ver : compact.getEdge(edge)->getEdgeVersions()) {
+      edgeVersions.push_back(ver);
+    } // End loop for versions
+    edges[edge].versionCount = edgeVersions.size() - edges[edge].firstVersion;
+  } // End loop for edges
+  edgeListHeader header;
+  header.magic = edgeListMagic;
+  header.format = edgeListFormat;
+  header.graphVersion = graph->getGraphVersion();
+  header.stringCount = strings.size();
+  header.functionCount = functions.size();
+  header.nodeCount = nodes.size();
+  header.lineNumberCount = lineNumbers.size();
+  header.edgeCount = edges.size();
+  header.edgeVersionCount = edgeVersions.size();
+  /* Arrays go straight into the buffered writer, without being gathered first */
+  const char padding[4] = {0, 0, 0, 0};
+  writer.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (auto &text : strings) {
+    uint32_t length = text.size();
+    writer.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    writer.write(text);
+    writer.write(padding, (4 - length % 4) % 4);
+  } // End loop for strings
+  writer.write(reinterpret_cast<const char *>(functions.data()), functions.size() * sizeof(edgeListFunction));
+  writer.write(reinterpret_cast<const char *>(nodes.data()), nodes.size() * sizeof(edgeListNode));
+  writer.write(reinterpret_cast<const char *>(lineNumbers.data()), lineNumbers.size() * sizeof(edgeListLineNumber));
+  writer.write(reinterpret_cast<const char *>(edges.data()), edges.size() * sizeof(edgeListEdge));
+  writer.write(reinterpret_cast<const char *>(edgeVersions.data()), edgeVersions.size() * sizeof(uint32_t));
+} // End exportGraph
+
+bool exportGraph(Graph *graph, std::string fileName, Graph_Exporter::exporterFormat format,
+                 Graph_Writer::writerCompression compression, unsigned threads) {
+  Graph_Exporter *exporter = Graph_Exporter::createExporter(format);
+  if (!exporter) {
+    return graph->printGraph(fileName, compression, threads);
+  } // End check for exporter
+  Graph_Writer writer;
+  if (!writer.openWriter(fileName + exporter->getExtension(), compression)) {
+    std::cerr << "Unable to open file for exporting the output\n";
+    delete exporter;
+    return false;
+  } // End check for writer
+  Graph_Compact compact(graph);
+  exporter->exportGraph(graph, compact, writer);
+  delete exporter;
+  return writer.closeWriter();
+} // End exportGraph
+} // namespace hydrogen_framework
@@ -0,0 +1,195 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Graph_Exporter Class: Writing a Graph in machine-readable formats
+ */
+#ifndef GRAPH_EXPORTER_H
+#define GRAPH_EXPORTER_H
+
+#include "Graph_Writer.hpp"
+#include <cstdint>
+#include <string>
+namespace hydrogen_framework {
+/* Forward declaration */
+class Graph;
+class Graph_Compact;
+
+/**
+ * Graph_Exporter Class: Interface of the output formats of a Graph
+ * Every exporter writes the instructions as nodes with their function, file and per-version line numbers, and the
+ * edges with their type and versions. Nodes are identified by their index in Graph_Compact
+ */
+class Graph_Exporter {
+public:
+  /**
+   * Enumeration for output formats
+   */
+  enum exporterFormat { DOT, GRAPHML, JSONL, EDGELIST };
+
+  /**
+   * Destructor
+   */
+  virtual ~Graph_Exporter() {}
+
+  /**
+   * Return the file extension of the format, including the dot
+   */
+  virtual std::string getExtension() = 0;
+
+  /**
+   * Write the given view of graph into writer
+   */
+  virtual void exportGraph(Graph *graph, const Graph_Compact &compact, Graph_Writer &writer) = 0;
+
+  /**
+   * Set format to the format with the given name
+   * Returns FALSE if there is no such format
+   */
+  static bool parseFormat(std::string name, exporterFormat &format);
+
+  /**
+   * Create the exporter of the given format. The caller owns it
+   * Returns NULL for DOT, which is written by Graph::printGraph
+   */
+  static Graph_Exporter *createExporter(exporterFormat format);
+}; // End Graph_Exporter Class
+
+/**
+ * GraphML_Exporter Class: Writes a GraphML document
+ * Line numbers are written as "version:line" pairs and edge versions as a comma separated list
+ */
+class GraphML_Exporter : public Graph_Exporter {
+public:
+  /**
+   * Return the file extension of GraphML
+   */
+  std::string getExtension() { return ".graphml"; }
+
+  /**
+   * Write the given view of graph into writer as GraphML
+   */
+  void exportGraph(Graph *graph, const Graph_Compact &compact, Graph_Writer &writer);
+
+private:
+  /**
+   * Append text to out with the XML special characters escaped
+   */
+  static void appendXMLEscaped(std::string &out, const std::string &text);
+}; // End GraphML_Exporter Class
+
+/**
+ * JSONL_Exporter Class: Writes one JSON object per line
+ * The first object describes the graph and is followed by one object per node and one per edge
+ * Objects are told apart by their "record" field
+ */
+class JSONL_Exporter : public Graph_Exporter {
+public:
+  /**
+   * Return the file extension of JSON lines
+   */
+  std::string getExtension() { return ".jsonl"; }
+
+  /**
+   * Write the given view of graph into writer as JSON lines
+   */
+  void exportGraph(Graph *graph, const Graph_Compact &compact, Graph_Writer &writer);
+
+private:
+  /**
+   * Append text to out as a quoted JSON string
+   */
+  static void appendJSONString(std::string &out, const std::string &text);
+}; // End JSONL_Exporter Class
+
+/**
+ * Edge list layout. Every field is a 32 bit unsigned integer in host byte order
+ * The header is followed by flat arrays in this order:
+ * strings (each a length followed by its bytes padded to 4 bytes), functions, nodes, line numbers, edges and edge
+ * versions
+ * Records refer to each other by their index in these arrays and to strings by their index in the string table
+ */
+typedef struct edgeListHeader {
+  uint32_t magic;            /**< Set to edgeListMagic */
+  uint32_t format;           /**< Set to edgeListFormat */
+  uint32_t graphVersion;     /**< Version of the Graph */
+  uint32_t stringCount;      /**< Number of strings in the string table */
+  uint32_t functionCount;    /**< Number of edgeListFunction */
+  uint32_t nodeCount;        /**< Number of edgeListNode */
+  uint32_t lineNumberCount;  /**< Number of edgeListLineNumber */
+  uint32_t edgeCount;        /**< Number of edgeListEdge */
+  uint32_t edgeVersionCount; /**< Number of edge versions */
+} edgeListHeader;
+
+/**
+ * Function owning a node of the edge list
+ */
+typedef struct edgeListFunction {
+  uint32_t name; /**< String index of the function name */
+  uint32_t file; /**< String index of the function file */
+} edgeListFunction;
+
+/**
+ * Node of the edge list. Its line numbers are stored contiguously
+ */
+typedef struct edgeListNode {
+  uint32_t instructionID;   /**< Instruction ID */
+  uint32_t function;        /**< Index of the edgeListFunction. Graph_Compact::noIndex if it has no line */
+  uint32_t firstLineNumber; /**< Index of the first edgeListLineNumber */
+  uint32_t lineNumberCount; /**< Number of line numbers */
+} edgeListNode;
+
+/**
+ * Line number of a node in one version
+ */
+typedef struct edgeListLineNumber {
+  uint32_t version; /**< Graph version */
+  uint32_t lineNo;  /**< Line number in the version */
+} edgeListLineNumber;
+
+/**
+ * Edge of the edge list. Its versions are stored contiguously
+ */
+typedef struct edgeListEdge {
+  uint32_t from;         /**< Index of the from edgeListNode */
+  uint32_t to;           /**< Index of the to edgeListNode */
+  uint32_t type;         /**< Graph_Edge::edgeTypes */
+  uint32_t firstVersion; /**< Index of the first edge version */
+  uint32_t versionCount; /**< Number of versions */
+} edgeListEdge;
+
+/**
+ * Identifies an edge list file
+ */
+const uint32_t edgeListMagic = 0x4c454748; /* HGEL */
+
+/**
+ * Bumped whenever the edge list layout changes
+ */
+const uint32_t edgeListFormat = 1;
+
+/**
+ * EdgeList_Exporter Class: Writes the compact binary edge list described by edgeListHeader
+ * Instruction labels are left out
+ */
+class EdgeList_Exporter : public Graph_Exporter {
+public:
+  /**
+   * Return the file extension of the edge list
+   */
+  std::string getExtension() { return ".edges"; }
+
+  /**
+   * Write the given view of graph into writer as a binary edge list
+   */
+  void exportGraph(Graph *graph, const Graph_Compact &compact, Graph_Writer &writer);
+}; // End EdgeList_Exporter Class
+
+/**
+ * Write graph into fileName followed by the extension of the format and of the compression
+ * DOT is formatted on the given number of threads, the other formats on the calling thread
+ * Returns FALSE if the output cannot be written
+ */
+bool exportGraph(Graph *graph, std::string fileName, Graph_Exporter::exporterFormat format,
+                 Graph_Writer::writerCompression compression, unsigned threads);
+} // namespace hydrogen_framework
+#endif
@@ -6,8 +6,8 @@
 #ifndef GRAPH_FUNCTION_H
 #define GRAPH_FUNCTION_H
 
-#include <list>
 #include <string>
+#include <vector>
 namespace hydrogen_framework {
 /* Forward declaration */
 class Graph;
@@ -28,6 +28,11 @@ public:
    */
   ~Graph_Function() { functionLines.clear(); }
 
+  /**
+   * Set functionID
+   */
+  void setFunctionID(unsigned id) { functionID = id; }
+
   /**
    * Set functionName
    */
@@ -61,7 +66,7 @@ public:
   /**
    * Return functionLines
    */
-  std::list<Graph_Line *> getFunctionLines() { return functionLines; }
+  const std::vector<Graph_Line *> &getFunctionLines() const { return functionLines; }
 
   /**
    * Return funcName
@@ -89,11 +94,11 @@ public:
   Graph *getGraph() { return funcGraph; }
 
 private:
-  unsigned functionID;                   /**< Function Container ID */
-  std::string functionName;              /**< Name of the function */
-  std::string functionFile;              /**< Name of the file in which the function resides */
-  std::list<Graph_Line *> functionLines; /**< Container for lines in the function */
-  Graph *funcGraph;                      /**< Points to the Graph that encompasses this */
-};                                       // End Graph_Function Class
+  unsigned functionID;                     /**< Function Container ID */
+  std::string functionName;                /**< Name of the function */
+  std::string functionFile;                /**< Name of the file in which the function resides */
+  std::vector<Graph_Line *> functionLines; /**< Container for lines in the function */
+  Graph *funcGraph;                        /**< Points to the Graph that encompasses this */
+};                                         // End Graph_Function Class
 } // namespace hydrogen_framework
 #endif
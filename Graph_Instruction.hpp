@@ -6,9 +6,10 @@
 #ifndef GRAPH_INSTRUCTION_H
 #define GRAPH_INSTRUCTION_H
 
-#include <list>
 #include <llvm/IR/Module.h>
+#include <llvm/Support/raw_ostream.h>
 #include <set>
+#include <vector>
 namespace hydrogen_framework {
 /* Forward declaration */
 class Graph_Edge;
@@ -23,7 +24,7 @@ public:
   /**
    * Constructor
    */
-  Graph_Instruction() : instructionID(0), instructionPtr(NULL), instructionLine(NULL) {}
+  Graph_Instruction() : instructionID(0), instructionOpcode(0), instructionPtr(NULL), instructionLine(NULL) {}
 
   /**
    * Destructor
@@ -41,9 +42,28 @@ public:
   void setInstructionLabel(std::string label) { instructionLabel = label; }
 
   /**
-   * Set instructionPtr
+   * Set instructionPtr and keep a copy of its OpCode in instructionOpcode
    */
-  void setInstructionPtr(llvm::Instruction *I) { instructionPtr = I; }
+  void setInstructionPtr(llvm::Instruction *I) {
+    instructionPtr = I;
+    instructionOpcode = I ? I->getOpcode() : 0;
+  }
+
+  /**
+   * Set instructionOpcode. Only used when restoring a Graph_Instruction without its LLVM Instruction
+   */
+  void setInstructionOpcode(unsigned opcode) { instructionOpcode = opcode; }
+
+  /**
+   * Drop instructionPtr before its LLVM Module is freed
+   * The label is printed into instructionLabel first, so instructionOpcode and the label remain valid
+   */
+  void detachInstructionPtr() {
+    if (instructionPtr && instructionLabel.empty()) {
+      instructionLabel = getInstructionLabel();
+    } // End check for instructionPtr
+    instructionPtr = NULL;
+  }
 
   /**
    * Push Graph_Edge into instructionEdges list
@@ -52,14 +72,30 @@ public:
 
   /**
    * Return instructionLabel
+   * Without a stored label, instructionPtr is printed on every call instead, so only virtual nodes, restored and
+   * detached instructions keep their text in memory
    */
-  std::string getInstructionLabel() { return instructionLabel; }
+  std::string getInstructionLabel() {
+    if (!instructionPtr || !instructionLabel.empty()) {
+      return instructionLabel;
+    } // End check for stored label
+    std::string label;
+    llvm::raw_string_ostream rLabel(label);
+    instructionPtr->print(rLabel);
+    return rLabel.str();
+  }
 
   /**
    * Return instructionID
    */
   unsigned getInstructionID() { return instructionID; }
 
+  /**
+   * Return instructionOpcode
+   * Zero for virtual nodes
+   */
+  unsigned getInstructionOpcode() { return instructionOpcode; }
+
   /**
    * Get instructionPtr
    * Can return NULL
@@ -69,7 +105,7 @@ public:
   /**
    * Return instructionEdges
    */
-  std::list<Graph_Edge *> getInstructionEdges() { return instructionEdges; }
+  const std::vector<Graph_Edge *> &getInstructionEdges() const { return instructionEdges; }
 
   /**
    * Set pointer to encompassing Graph_Line
@@ -93,9 +129,10 @@ public:
 
 private:
   unsigned instructionID;                      /**< Instruction ID */
-  std::string instructionLabel;                /**< Instruction label or text */
+  std::string instructionLabel;                /**< Instruction label. Empty while printed from instructionPtr */
+  unsigned instructionOpcode;                  /**< LLVM OpCode of instructionPtr. Kept after it is detached */
   llvm::Instruction *instructionPtr;           /**< Instruction LLVM Pointer */
-  std::list<Graph_Edge *> instructionEdges;    /**< Container for edges in the instruction */
+  std::vector<Graph_Edge *> instructionEdges;  /**< Container for edges in the instruction */
   Graph_Line *instructionLine;                 /**< Points to the Graph_Line that encompasses this */
   std::set<Query *> instructionVisitedQueries; /**< Container for Queries that have visited this */
 };                                             // End Graph_Instruction Class
@@ -4,24 +4,64 @@
  * Implementing Graph_Line.hpp
  */
 #include "Graph_Line.hpp"
+#include "Graph.hpp"
+#include "Graph_Function.hpp"
 #include "Graph_Instruction.hpp"
+#include <algorithm>
 
 namespace hydrogen_framework {
+const uint64_t Graph_Line::signatureBasis;
+const uint64_t Graph_Line::signaturePrime;
 
 void Graph_Line::setLineNumber(unsigned Version, unsigned line) {
-  lineNumber.insert(std::pair<unsigned, unsigned>(Version, line));
+  if (!lineVersions.insert(Version)) {
+    return;
+  } // End check for existing line number
+  if (Version >= lineNumber.size()) {
+    lineNumber.resize(Version + 1, 0);
+  } // End check for lineNumber size
+  lineNumber[Version] = line;
+  /* Keep the line index of the encompassing Graph up to date */
+  if (lineFunction && lineFunction->getGraph()) {
+    lineFunction->getGraph()->indexLineNumber(this, Version, line);
+  } // End check for new line number
 } // End setLineNumber
 
 void Graph_Line::pushLineInstruction(Graph_Instruction *inst) {
   inst->setGraphLine(this);
   lineInstructions.push_back(inst);
+  /* If OpCode is not found, then it is a virtual node and won't be present in the other version as well */
+  if (inst->getInstructionOpcode() != 0) {
+    lineOpcodes.push_back(inst->getInstructionOpcode());
+    lineSignature = (lineSignature ^ inst->getInstructionOpcode()) * signaturePrime;
+  } // End check for Instruction OpCode
 } // End pushLineInstruction;
 
-unsigned Graph_Line::getLineNumber(unsigned Version) {
-  auto searchLine = lineNumber.find(Version);
-  if (searchLine != lineNumber.end()) {
-    return searchLine->second;
-  } // End check for searchLine
+unsigned Graph_Line::getOpcodeDistance(const Graph_Line *other) const {
+  const std::vector<uint16_t> &from = lineOpcodes;
+  const std::vector<uint16_t> &to = other->lineOpcodes;
+  /* Two rows of the edit distance table are enough */
+  std::vector<unsigned> previous(to.size() + 1);
+  std::vector<unsigned> current(to.size() + 1);
+  for (std::size_t col = 0; col <= to.size(); ++col) {
+    previous[col] = col;
+  } // End loop for first row
+  for (std::size_t row = 1; row <= from.size(); ++row) {
+    current[0] = row;
+    for (std::size_t col = 1; col <= to.size(); ++col) {
+      unsigned replace = previous[col - 1] + (from[row - 1] == to[col - 1] ? 0 : 1);
+      current[col] = std::min(replace, std::min(previous[col], current[col - 1]) + 1);
+    } // End loop for col
+    previous.swap(current);
+  } // End loop for row
+  return previous[to.size()];
+} // End getOpcodeDistance
+
+unsigned Graph_Line::getLineNumber(unsigned Version) const {
+  /* Versions without a line number are zero in lineNumber */
+  if (Version < lineNumber.size()) {
+    return lineNumber[Version];
+  } // End check for Version
   return 0;
 } // End getLineNumber
 } // namespace hydrogen_framework
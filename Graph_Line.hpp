@@ -6,8 +6,9 @@
 #ifndef GRAPH_LINE_H
 #define GRAPH_LINE_H
 
-#include <list>
-#include <map>
+#include "Graph_Versions.hpp"
+#include <cstdint>
+#include <vector>
 namespace hydrogen_framework {
 /* Forward declaration */
 class Graph_Function;
@@ -21,7 +22,7 @@ public:
   /**
    * Constructor
    */
-  Graph_Line(unsigned Version) : lineFunction(NULL), lineGraphVersion(Version) {}
+  Graph_Line(unsigned Version) : lineSignature(signatureBasis), lineFunction(NULL), lineGraphVersion(Version) {}
 
   /**
    * Destructor
@@ -32,13 +33,19 @@ public:
    * Get lineNumber given a version
    * Returns zero if no mapping found
    */
-  unsigned getLineNumber(unsigned Version);
+  unsigned getLineNumber(unsigned Version) const;
 
   /**
    * Set lineNumber
+   * Existing line number for the Version is not overwritten
    */
   void setLineNumber(unsigned Version, unsigned line);
 
+  /**
+   * Return lineVersions, the versions having a line number
+   */
+  const Graph_Versions &getLineVersions() const { return lineVersions; }
+
   /**
    * Return true if lineInstructions is empty
    */
@@ -46,13 +53,38 @@ public:
 
   /**
    * Push the Graph_Instruction at the back of the list
+   * Its OpCode is added to lineOpcodes and lineSignature, so it must be set before
    */
   void pushLineInstruction(Graph_Instruction *inst);
 
+  /**
+   * Return lineOpcodes, the OpCodes of the instructions in the order in which they appear
+   * Virtual nodes have no OpCode and are left out
+   */
+  const std::vector<uint16_t> &getLineOpcodes() const { return lineOpcodes; }
+
+  /**
+   * Return lineSignature, the FNV-1a hash of lineOpcodes
+   */
+  uint64_t getLineSignature() const { return lineSignature; }
+
+  /**
+   * Return TRUE if both Graph_Lines have the same OpCodes in the same order
+   */
+  bool isSameOpcodes(const Graph_Line *other) const {
+    return lineSignature == other->lineSignature && lineOpcodes == other->lineOpcodes;
+  }
+
+  /**
+   * Return the edit distance between the OpCodes of both Graph_Lines
+   * This is the number of OpCodes to insert, delete or replace to turn one into the other
+   */
+  unsigned getOpcodeDistance(const Graph_Line *other) const;
+
   /**
    * Return lineInstructions
    */
-  std::list<Graph_Instruction *> getLineInstructions() { return lineInstructions; }
+  const std::vector<Graph_Instruction *> &getLineInstructions() const { return lineInstructions; }
 
   /**
    * Set pointer to encompassing Graph_Function
@@ -70,10 +102,16 @@ public:
   unsigned getLineGraphVersion() { return lineGraphVersion; }
 
 private:
-  std::map<unsigned, unsigned> lineNumber;         /**< Map between graphVersion and line Number */
-  std::list<Graph_Instruction *> lineInstructions; /**< Container for instruction in the line */
-  Graph_Function *lineFunction;                    /**< Points to the Graph_Function that encompasses this */
-  unsigned lineGraphVersion;                       /**< The graph version in which this line was introduced */
-};                                                 // End Graph_Line Class
+  static const uint64_t signatureBasis = 14695981039346656037ULL; /**< FNV-1a offset basis */
+  static const uint64_t signaturePrime = 1099511628211ULL;        /**< FNV-1a prime */
+
+  Graph_Versions lineVersions;                       /**< Versions having a line number */
+  std::vector<unsigned> lineNumber;                  /**< Line number of every version in lineVersions */
+  std::vector<Graph_Instruction *> lineInstructions; /**< Container for instruction in the line */
+  std::vector<uint16_t> lineOpcodes;                 /**< OpCodes of lineInstructions without virtual nodes */
+  uint64_t lineSignature;                            /**< Hash of lineOpcodes */
+  Graph_Function *lineFunction;                      /**< Points to the Graph_Function that encompasses this */
+  unsigned lineGraphVersion;                         /**< The graph version in which this line was introduced */
+};                                                   // End Graph_Line Class
 } // namespace hydrogen_framework
 #endif
@@ -0,0 +1,47 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Implementing Graph_Slice.hpp
+ */
+#include "Graph_Slice.hpp"
+#include "Graph.hpp"
+#include "Graph_Edge.hpp"
+#include "Graph_Instruction.hpp"
+#include "Graph_Line.hpp"
+namespace hydrogen_framework {
+const std::vector<Graph_Line *> &Graph_Slice::getSliceLines() const {
+  return sliceGraph->getVersionLines(sliceVersion);
+} // End getSliceLines
+
+const std::vector<Graph_Edge *> &Graph_Slice::getSliceEdges() const {
+  return sliceGraph->getVersionEdges(sliceVersion);
+} // End getSliceEdges
+
+bool Graph_Slice::isLineInSlice(Graph_Line *line) const {
+  return line->getLineNumber(sliceVersion) != 0;
+} // End isLineInSlice
+
+bool Graph_Slice::isEdgeInSlice(Graph_Edge *edge) const {
+  return edge->isPartOfGraph(sliceVersion);
+} // End isEdgeInSlice
+
+std::vector<Graph_Edge *> Graph_Slice::getOutEdges(Graph_Instruction *inst) const {
+  std::vector<Graph_Edge *> outEdges;
+  for (auto edge : inst->getInstructionEdges()) {
+    if (edge->getEdgeFrom() == inst && edge->isPartOfGraph(sliceVersion)) {
+      outEdges.push_back(edge);
+    } // End check for edge
+  }   // End loop for edges
+  return outEdges;
+} // End getOutEdges
+
+std::vector<Graph_Edge *> Graph_Slice::getInEdges(Graph_Instruction *inst) const {
+  std::vector<Graph_Edge *> inEdges;
+  for (auto edge : inst->getInstructionEdges()) {
+    if (edge->getEdgeTo() == inst && edge->isPartOfGraph(sliceVersion)) {
+      inEdges.push_back(edge);
+    } // End check for edge
+  }   // End loop for edges
+  return inEdges;
+} // End getInEdges
+} // namespace hydrogen_framework
@@ -0,0 +1,74 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Graph_Slice Class: Read-only view of a single version of a Graph
+ */
+#ifndef GRAPH_SLICE_H
+#define GRAPH_SLICE_H
+
+#include <vector>
+namespace hydrogen_framework {
+/* Forward declaration */
+class Graph;
+class Graph_Edge;
+class Graph_Instruction;
+class Graph_Line;
+
+/**
+ * Graph_Slice Class: The Graph_Lines and Graph_Edges of a Graph that are part of one version
+ * Backed by the version index of the Graph, so it costs nothing to create and follows later changes to the Graph
+ * A Graph_Line is part of a version when its line number for the version is not zero
+ */
+class Graph_Slice {
+public:
+  /**
+   * Constructor
+   */
+  Graph_Slice(Graph *graph, unsigned version) : sliceGraph(graph), sliceVersion(version) {}
+
+  /**
+   * Destructor
+   */
+  ~Graph_Slice() {}
+
+  /**
+   * Return sliceVersion
+   */
+  unsigned getSliceVersion() const { return sliceVersion; }
+
+  /**
+   * Return the Graph_Lines of the version
+   */
+  const std::vector<Graph_Line *> &getSliceLines() const;
+
+  /**
+   * Return the Graph_Edges of the version
+   */
+  const std::vector<Graph_Edge *> &getSliceEdges() const;
+
+  /**
+   * Return TRUE if the Graph_Line is part of the version
+   */
+  bool isLineInSlice(Graph_Line *line) const;
+
+  /**
+   * Return TRUE if the Graph_Edge is part of the version
+   */
+  bool isEdgeInSlice(Graph_Edge *edge) const;
+
+  /**
+   * Return the Graph_Edges of the version leaving the given Graph_Instruction
+   */
+  std::vector<Graph_Edge *> getOutEdges(Graph_Instruction *inst) const;
+
+  /**
+   * Return the Graph_Edges of the version entering the given Graph_Instruction
+   */
+  std::vector<Graph_Edge *> getInEdges(Graph_Instruction *inst) const;
+
+private:
+  Graph *sliceGraph;     /**< Graph being viewed */
+  unsigned sliceVersion; /**< Version being viewed */
+};                       // End Graph_Slice Class
+} // namespace hydrogen_framework
+#endif
@@ -0,0 +1,336 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Implementing Graph_Snapshot.hpp
+ */
+#include "Graph_Snapshot.hpp"
+#include "Graph.hpp"
+#include "Graph_Edge.hpp"
+#include "Graph_Function.hpp"
+#include "Graph_Instruction.hpp"
+#include "Graph_Line.hpp"
+#include "Source_File.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_set>
+namespace hydrogen_framework {
+bool saveSnapshot(Graph *graph, std::list<std::string> files, std::string snapshotFile) {
+  /* String table */
+  std::vector<std::string> strings;
+  std::unordered_map<std::string, uint32_t> stringIDs;
+  auto internString = [&](const std::string &str) -> uint32_t {
+    auto findString = stringIDs.find(str);
+    if (findString != stringIDs.end()) {
+      return findString->second;
+    } // End check for findString
+    uint32_t stringID = strings.size();
+    stringIDs.insert(std::pair<std::string, uint32_t>(str, stringID));
+    strings.push_back(str);
+    return stringID;
+  };
+  /* Functions of the Graph come first, followed by the ones only reachable from its edges */
+  std::vector<Graph_Function *> functions;
+  std::unordered_set<Graph_Function *> seenFunctions;
+  for (auto func : graph->getGraphFunctions()) {
+    functions.push_back(func);
+    seenFunctions.insert(func);
+  } // End loop for graphFunctions
+  std::size_t attachedCount = functions.size();
+  const std::vector<Graph_Edge *> &edges = graph->getGraphEdges();
+  for (auto edge : edges) {
+    for (auto inst : {edge->getEdgeFrom(), edge->getEdgeTo()}) {
+      if (!inst->getGraphLine() || !inst->getGraphLine()->getGraphFunction()) {
+        std::cerr << "Unable to save " << inst->getInstructionLabel() << " without its Graph_Function\n";
+        return false;
+      } // End check for getGraphFunction
+      Graph_Function *func = inst->getGraphLine()->getGraphFunction();
+      if (seenFunctions.insert(func).second) {
+        functions.push_back(func);
+      } // End check for seenFunctions
+    }   // End loop for inst
+  }     // End loop for edges
+  /* Flatten functions, lines and instructions */
+  std::vector<snapshotFunction> snapFunctions;
+  std::vector<snapshotLine> snapLines;
+  std::vector<snapshotInstruction> snapInstructions;
+  std::vector<Graph_Line *> lines;
+  std::unordered_map<Graph_Instruction *, uint32_t> instructionIndex;
+  for (std::size_t iter = 0; iter < functions.size(); ++iter) {
+    snapshotFunction snapFunc;
+    snapFunc.functionID = functions[iter]->getFunctionID();
+    snapFunc.name = internString(functions[iter]->getFunctionName());
+    snapFunc.file = internString(functions[iter]->getFunctionFile());
+    snapFunc.attached = iter < attachedCount ? 1 : 0;
+    snapFunc.firstLine = snapLines.size();
+    for (auto line : functions[iter]->getFunctionLines()) {
+      snapshotLine snapLine;
+      snapLine.graphVersion = line->getLineGraphVersion();
+      snapLine.firstInstruction = snapInstructions.size();
+      for (auto inst : line->getLineInstructions()) {
+        snapshotInstruction snapInst;
+        snapInst.instructionID = inst->getInstructionID();
+        snapInst.label = internString(inst->getInstructionLabel());
+        snapInst.opcode = inst->getInstructionOpcode();
+        instructionIndex.insert(std::pair<Graph_Instruction *, uint32_t>(inst, snapInstructions.size()));
+        snapInstructions.push_back(snapInst);
+      } // End loop for inst
+      snapLine.instructionCount = snapInstructions.size() - snapLine.firstInstruction;
+      lines.push_back(line);
+      snapLines.push_back(snapLine);
+    } // End loop for line
+    snapFunc.lineCount = snapLines.size() - snapFunc.firstLine;
+    snapFunctions.push_back(snapFunc);
+  } // End loop for functions
+  /* Line numbers are ordered by their position in the line index of the Graph so that restoring keeps that order */
+  std::vector<std::pair<uint32_t, snapshotLineNumber>> rankedLineNumbers;
+  for (std::size_t iter = 0; iter < lines.size(); ++iter) {
+    std::string fileName = lines[iter]->getGraphFunction()->getFunctionFile();
+    for (auto ver : lines[iter]->getLineVersions()) {
+      unsigned lineNo = lines[iter]->getLineNumber(ver);
+      const std::vector<Graph_Line *> &indexedLines = graph->getGraphLines(fileName, ver, lineNo);
+      auto findLine = std::find(indexedLines.begin(), indexedLines.end(), lines[iter]);
+      snapshotLineNumber snapLineNo;
+      snapLineNo.line = iter;
+      snapLineNo.version = ver;
+      snapLineNo.lineNo = lineNo;
+      uint32_t rank = findLine != indexedLines.end() ? findLine - indexedLines.begin() : 0;
+      rankedLineNumbers.push_back(std::pair<uint32_t, snapshotLineNumber>(rank, snapLineNo));
+    } // End loop for ver
+  }   // End loop for lines
+  std::stable_sort(
+      rankedLineNumbers.begin(), rankedLineNumbers.end(),
+      [](const std::pair<uint32_t, snapshotLineNumber> &a, const std::pair<uint32_t, snapshotLineNumber> &b) {
+        return a.first < b.first;
+      });
+  std::vector<snapshotLineNumber> snapLineNumbers;
+  for (auto rankedLineNo : rankedLineNumbers) {
+    snapLineNumbers.push_back(rankedLineNo.second);
+  } // End loop for rankedLineNumbers
+  /* Edges in the order of the Graph so that every Graph_Instruction gets its edges back in the same order */
+  std::vector<snapshotEdge> snapEdges;
+  std::vector<uint32_t> edgeVersions;
+  for (auto edge : edges) {
+    snapshotEdge snapEdge;
+    snapEdge.from = instructionIndex[edge->getEdgeFrom()];
+    snapEdge.to = instructionIndex[edge->getEdgeTo()];
+    snapEdge.type = edge->getEdgeType();
+    snapEdge.firstVersion = edgeVersions.size();
+    for (auto ver : edge->getEdgeVersions()) {
+      edgeVersions.push_back(ver);
+    } // End loop for getEdgeVersions
+    snapEdge.versionCount = edgeVersions.size() - snapEdge.firstVersion;
+    snapEdges.push_back(snapEdge);
+  } // End loop for edges
+  /* Contents are saved as well, since the files may be changed in place before the next version is appended */
+  std::vector<uint32_t> snapFiles;
+  std::vector<uint32_t> snapFileContents;
+  for (auto file : files) {
+    Source_File sourceFile(file);
+    if (!sourceFile.mapFile()) {
+      return false;
+    } // End check for mapFile
+    snapFiles.push_back(internString(file));
+    snapFileContents.push_back(internString(sourceFile.getContents()));
+  } // End loop for files
+  std::vector<uint32_t> stringOffsets(1, 0);
+  std::string stringBytes;
+  for (auto str : strings) {
+    stringBytes += str;
+    stringOffsets.push_back(stringBytes.size());
+  } // End loop for strings
+  snapshotHeader header;
+  header.magic = snapshotMagic;
+  header.format = snapshotFormat;
+  header.graphVersion = graph->getGraphVersion();
+  header.graphID = graph->getGraphID();
+  header.stringCount = strings.size();
+  header.stringBytes = stringBytes.size();
+  header.fileCount = snapFiles.size();
+  header.functionCount = snapFunctions.size();
+  header.lineCount = snapLines.size();
+  header.lineNumberCount = snapLineNumbers.size();
+  header.instructionCount = snapInstructions.size();
+  header.edgeCount = snapEdges.size();
+  header.edgeVersionCount = edgeVersions.size();
+  /* Keep every array after the string bytes aligned to 4 bytes */
+  stringBytes.resize((stringBytes.size() + 3) & ~static_cast<std::size_t>(3), '\0');
+  std::ofstream sFile(snapshotFile, std::ios::binary | std::ios::trunc);
+  if (!sFile.is_open()) {
+    std::cerr << "Unable to open " << snapshotFile << " for writing the snapshot\n";
+    return false;
+  } // End check for sFile
+  sFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  sFile.write(reinterpret_cast<const char *>(stringOffsets.data()), stringOffsets.size() * sizeof(uint32_t));
+  sFile.write(stringBytes.data(), stringBytes.size());
+  sFile.write(reinterpret_cast<const char *>(snapFiles.data()), snapFiles.size() * sizeof(uint32_t));
+  sFile.write(reinterpret_cast<const char *>(snapFileContents.data()), snapFileContents.size() * sizeof(uint32_t));
+  sFile.write(reinterpret_cast<const char *>(snapFunctions.data()), snapFunctions.size() * sizeof(snapshotFunction));
+  sFile.write(reinterpret_cast<const char *>(snapLines.data()), snapLines.size() * sizeof(snapshotLine));
+  sFile.write(reinterpret_cast<const char *>(snapLineNumbers.data()),
+              snapLineNumbers.size() * sizeof(snapshotLineNumber));
+  sFile.write(reinterpret_cast<const char *>(snapInstructions.data()),
+              snapInstructions.size() * sizeof(snapshotInstruction));
+  sFile.write(reinterpret_cast<const char *>(snapEdges.data()), snapEdges.size() * sizeof(snapshotEdge));
+  sFile.write(reinterpret_cast<const char *>(edgeVersions.data()), edgeVersions.size() * sizeof(uint32_t));
+  if (!sFile) {
+    std::cerr << "Unable to write the snapshot " << snapshotFile << "\n";
+    return false;
+  } // End check for sFile
+  return true;
+} // End saveSnapshot
+
+Graph *loadSnapshot(std::string snapshotFile, std::list<std::string> &files, std::list<std::string> &contents) {
+  int fd = open(snapshotFile.c_str(), O_RDONLY);
+  if (fd == -1) {
+    std::cerr << "Unable to open the snapshot " << snapshotFile << "\n";
+    return NULL;
+  } // End check for fd
+  struct stat buffer;
+  if (fstat(fd, &buffer) == -1 || buffer.st_size < static_cast<off_t>(sizeof(snapshotHeader))) {
+    std::cerr << snapshotFile << " is not a snapshot\n";
+    close(fd);
+    return NULL;
+  } // End check for fstat
+  std::size_t size = buffer.st_size;
+  void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    std::cerr << "Unable to map the snapshot " << snapshotFile << "\n";
+    return NULL;
+  } // End check for mapping
+  const char *base = static_cast<const char *>(mapping);
+  snapshotHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  /* Locate the arrays. The mapping is page aligned and so is every array */
+  std::size_t offset = sizeof(header);
+  bool valid = header.magic == snapshotMagic && header.format == snapshotFormat;
+  auto takeArray = [&](uint64_t count, std::size_t width) -> const char * {
+    uint64_t bytes = (count * width + 3) & ~static_cast<uint64_t>(3);
+    if (!valid || bytes > size - offset) {
+      valid = false;
+      return base;
+    } // End check for size
+    const char *array = base + offset;
+    offset += bytes;
+    return array;
+  };
+  auto stringOffsets = reinterpret_cast<const uint32_t *>(takeArray(header.stringCount + 1ULL, sizeof(uint32_t)));
+  auto stringBytes = takeArray(header.stringBytes, 1);
+  auto snapFiles = reinterpret_cast<const uint32_t *>(takeArray(header.fileCount, sizeof(uint32_t)));
+  auto snapFileContents = reinterpret_cast<const uint32_t *>(takeArray(header.fileCount, sizeof(uint32_t)));
+  auto snapFunctions =
+      reinterpret_cast<const snapshotFunction *>(takeArray(header.functionCount, sizeof(snapshotFunction)));
+  auto snapLines = reinterpret_cast<const snapshotLine *>(takeArray(header.lineCount, sizeof(snapshotLine)));
+  auto snapLineNumbers =
+      reinterpret_cast<const snapshotLineNumber *>(takeArray(header.lineNumberCount, sizeof(snapshotLineNumber)));
+  auto snapInstructions =
+      reinterpret_cast<const snapshotInstruction *>(takeArray(header.instructionCount, sizeof(snapshotInstruction)));
+  auto snapEdges = reinterpret_cast<const snapshotEdge *>(takeArray(header.edgeCount, sizeof(snapshotEdge)));
+  auto edgeVersions = reinterpret_cast<const uint32_t *>(takeArray(header.edgeVersionCount, sizeof(uint32_t)));
+  /* Check every index before building anything */
+  /* Versions size the per-version containers, so they must lie within the versions of the Graph */
+  valid = valid && header.graphVersion != std::numeric_limits<uint32_t>::max();
+  /* Every version numbers some line, so a Graph with more versions than line numbers is damaged */
+  valid = valid && header.graphVersion <= header.lineNumberCount;
+  auto isVersion = [&](uint32_t version) -> bool { return version > 0 && version <= header.graphVersion; };
+  for (uint32_t iter = 0; valid && iter < header.stringCount; ++iter) {
+    valid = stringOffsets[iter] <= stringOffsets[iter + 1] && stringOffsets[iter + 1] <= header.stringBytes;
+  } // End loop for stringOffsets
+  for (uint32_t iter = 0; valid && iter < header.fileCount; ++iter) {
+    valid = snapFiles[iter] < header.stringCount && snapFileContents[iter] < header.stringCount;
+  } // End loop for snapFiles
+  uint64_t nextLine = 0;
+  for (uint32_t iter = 0; valid && iter < header.functionCount; ++iter) {
+    valid = snapFunctions[iter].name < header.stringCount && snapFunctions[iter].file < header.stringCount &&
+            snapFunctions[iter].firstLine == nextLine;
+    nextLine += snapFunctions[iter].lineCount;
+  } // End loop for snapFunctions
+  valid = valid && nextLine == header.lineCount;
+  uint64_t nextInstruction = 0;
+  for (uint32_t iter = 0; valid && iter < header.lineCount; ++iter) {
+    valid = snapLines[iter].firstInstruction == nextInstruction && isVersion(snapLines[iter].graphVersion);
+    nextInstruction += snapLines[iter].instructionCount;
+  } // End loop for snapLines
+  valid = valid && nextInstruction == header.instructionCount;
+  for (uint32_t iter = 0; valid && iter < header.lineNumberCount; ++iter) {
+    valid = snapLineNumbers[iter].line < header.lineCount && isVersion(snapLineNumbers[iter].version);
+  } // End loop for snapLineNumbers
+  for (uint32_t iter = 0; valid && iter < header.instructionCount; ++iter) {
+    valid = snapInstructions[iter].label < header.stringCount;
+  } // End loop for snapInstructions
+  for (uint32_t iter = 0; valid && iter < header.edgeCount; ++iter) {
+    valid = snapEdges[iter].from < header.instructionCount && snapEdges[iter].to < header.instructionCount &&
+            snapEdges[iter].type <= Graph_Edge::ANY && snapEdges[iter].versionCount > 0 &&
+            static_cast<uint64_t>(snapEdges[iter].firstVersion) + snapEdges[iter].versionCount <=
+                header.edgeVersionCount;
+  } // End loop for snapEdges
+  for (uint32_t iter = 0; valid && iter < header.edgeVersionCount; ++iter) {
+    valid = isVersion(edgeVersions[iter]);
+  } // End loop for edgeVersions
+  if (!valid) {
+    std::cerr << snapshotFile << " is not a valid snapshot\n";
+    munmap(mapping, size);
+    return NULL;
+  } // End check for valid
+  auto getString = [&](uint32_t index) {
+    return std::string(stringBytes + stringOffsets[index], stringOffsets[index + 1] - stringOffsets[index]);
+  };
+  /* Rebuild the Graph */
+  Graph *graph = new Graph(header.graphVersion);
+  std::vector<Graph_Line *> lines;
+  std::vector<Graph_Instruction *> instructions;
+  for (uint32_t iterFunc = 0; iterFunc < header.functionCount; ++iterFunc) {
+    const snapshotFunction &snapFunc = snapFunctions[iterFunc];
+    Graph_Function *func = graph->getArena().newFunction(snapFunc.functionID);
+    func->setFunctionName(getString(snapFunc.name));
+    func->setFunctionFile(getString(snapFunc.file));
+    for (uint32_t iterLine = snapFunc.firstLine; iterLine < snapFunc.firstLine + snapFunc.lineCount; ++iterLine) {
+      const snapshotLine &snapLine = snapLines[iterLine];
+      Graph_Line *line = graph->getArena().newLine(snapLine.graphVersion);
+      for (uint32_t iterInst = snapLine.firstInstruction;
+           iterInst < snapLine.firstInstruction + snapLine.instructionCount; ++iterInst) {
+        Graph_Instruction *inst = graph->getArena().newInstruction();
+        inst->setInstructionID(snapInstructions[iterInst].instructionID);
+        inst->setInstructionLabel(getString(snapInstructions[iterInst].label));
+        inst->setInstructionOpcode(snapInstructions[iterInst].opcode);
+        line->pushLineInstruction(inst);
+        instructions.push_back(inst);
+      } // End loop for iterInst
+      func->pushFunctionLines(line);
+      lines.push_back(line);
+    } // End loop for iterLine
+    if (snapFunc.attached) {
+      graph->pushGraphFunction(func);
+    } // End check for attached
+  }   // End loop for iterFunc
+  /* Line numbers are set after the functions are attached so that the line index is rebuilt in the saved order */
+  for (uint32_t iter = 0; iter < header.lineNumberCount; ++iter) {
+    lines[snapLineNumbers[iter].line]->setLineNumber(snapLineNumbers[iter].version, snapLineNumbers[iter].lineNo);
+  } // End loop for snapLineNumbers
+  for (uint32_t iter = 0; iter < header.edgeCount; ++iter) {
+    const snapshotEdge &snapEdge = snapEdges[iter];
+    Graph_Instruction *from = instructions[snapEdge.from];
+    Graph_Instruction *to = instructions[snapEdge.to];
+    Graph_Edge *edge = graph->getArena().newEdge(from, to, static_cast<Graph_Edge::edgeTypes>(snapEdge.type),
+                                                 edgeVersions[snapEdge.firstVersion]);
+    for (uint32_t iterVer = 1; iterVer < snapEdge.versionCount; ++iterVer) {
+      edge->pushEdgeVersions(edgeVersions[snapEdge.firstVersion + iterVer]);
+    } // End loop for iterVer
+    graph->addEdge(from, to, edge);
+  } // End loop for snapEdges
+  graph->setGraphID(header.graphID);
+  files.clear();
+  contents.clear();
+  for (uint32_t iter = 0; iter < header.fileCount; ++iter) {
+    files.push_back(getString(snapFiles[iter]));
+    contents.push_back(getString(snapFileContents[iter]));
+  } // End loop for snapFiles
+  munmap(mapping, size);
+  return graph;
+} // End loadSnapshot
+} // namespace hydrogen_framework
@@ -0,0 +1,115 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Graph_Snapshot : Saving a Graph into a binary snapshot and restoring it
+ */
+#ifndef GRAPH_SNAPSHOT_H
+#define GRAPH_SNAPSHOT_H
+
+#include <cstdint>
+#include <list>
+#include <string>
+namespace hydrogen_framework {
+/* Forward declaration */
+class Graph;
+
+/**
+ * Snapshot layout. Every field is a 32 bit unsigned integer in host byte order
+ * The header is followed by flat arrays in this order:
+ * string offsets (stringCount + 1), string bytes (padded to 4 bytes), files, file contents, functions, lines,
+ * line numbers, instructions, edges and edge versions
+ * Objects refer to each other by their index in these arrays and to strings by their index in the string table
+ */
+typedef struct snapshotHeader {
+  uint32_t magic;            /**< Set to snapshotMagic */
+  uint32_t format;           /**< Set to snapshotFormat */
+  uint32_t graphVersion;     /**< Version of the Graph */
+  uint32_t graphID;          /**< Last ID handed out by the Graph */
+  uint32_t stringCount;      /**< Number of strings in the string table */
+  uint32_t stringBytes;      /**< Number of bytes used by the strings without padding */
+  uint32_t fileCount;        /**< Number of source files of the last version */
+  uint32_t functionCount;    /**< Number of snapshotFunction */
+  uint32_t lineCount;        /**< Number of snapshotLine */
+  uint32_t lineNumberCount;  /**< Number of snapshotLineNumber */
+  uint32_t instructionCount; /**< Number of snapshotInstruction */
+  uint32_t edgeCount;        /**< Number of snapshotEdge */
+  uint32_t edgeVersionCount; /**< Number of edge versions */
+} snapshotHeader;
+
+/**
+ * Snapshot of a Graph_Function. Its lines are stored contiguously
+ */
+typedef struct snapshotFunction {
+  uint32_t functionID; /**< Function Container ID */
+  uint32_t name;       /**< String index of the function name */
+  uint32_t file;       /**< String index of the function file */
+  uint32_t attached;   /**< One if the function is part of the Graph, zero if it is only reachable from an edge */
+  uint32_t firstLine;  /**< Index of the first snapshotLine */
+  uint32_t lineCount;  /**< Number of lines */
+} snapshotFunction;
+
+/**
+ * Snapshot of a Graph_Line. Its instructions are stored contiguously
+ */
+typedef struct snapshotLine {
+  uint32_t graphVersion;     /**< The graph version in which the line was introduced */
+  uint32_t firstInstruction; /**< Index of the first snapshotInstruction */
+  uint32_t instructionCount; /**< Number of instructions */
+} snapshotLine;
+
+/**
+ * Snapshot of one line number of a Graph_Line
+ * Stored in the order in which the Graph registered them, so that the restored line index has the same order
+ */
+typedef struct snapshotLineNumber {
+  uint32_t line;    /**< Index of the snapshotLine */
+  uint32_t version; /**< Graph version */
+  uint32_t lineNo;  /**< Line number in the version */
+} snapshotLineNumber;
+
+/**
+ * Snapshot of a Graph_Instruction
+ */
+typedef struct snapshotInstruction {
+  uint32_t instructionID; /**< Instruction ID */
+  uint32_t label;         /**< String index of the instruction label */
+  uint32_t opcode;        /**< LLVM OpCode. Zero for virtual nodes */
+} snapshotInstruction;
+
+/**
+ * Snapshot of a Graph_Edge. Its versions are stored contiguously
+ */
+typedef struct snapshotEdge {
+  uint32_t from;         /**< Index of the from snapshotInstruction */
+  uint32_t to;           /**< Index of the to snapshotInstruction */
+  uint32_t type;         /**< Graph_Edge::edgeTypes */
+  uint32_t firstVersion; /**< Index of the first edge version */
+  uint32_t versionCount; /**< Number of versions */
+} snapshotEdge;
+
+/**
+ * Identifies a snapshot file
+ */
+const uint32_t snapshotMagic = 0x50414e53; /* SNAP */
+
+/**
+ * Bumped whenever the snapshot layout changes
+ */
+const uint32_t snapshotFormat = 2;
+
+/**
+ * Save graph and the paths and contents of the source files of its last version into snapshotFile
+ * LLVM Instructions are not saved. Labels and OpCodes are
+ * Returns FALSE if a source file cannot be read or the snapshot cannot be written
+ */
+bool saveSnapshot(Graph *graph, std::list<std::string> files, std::string snapshotFile);
+
+/**
+ * Restore the Graph saved in snapshotFile, and the source files of its last version into files and their
+ * contents at the time of saving into contents
+ * The restored Graph_Instructions have no LLVM Instruction
+ * Returns NULL if snapshotFile cannot be read or is not a valid snapshot
+ */
+Graph *loadSnapshot(std::string snapshotFile, std::list<std::string> &files, std::list<std::string> &contents);
+} // namespace hydrogen_framework
+#endif
@@ -0,0 +1,57 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Implementing Graph_Versions.hpp
+ */
+#include "Graph_Versions.hpp"
+namespace hydrogen_framework {
+const unsigned Graph_Versions::wordBits;
+
+void Graph_Versions::const_iterator::seekVersion() {
+  std::size_t word = iterVersion / wordBits;
+  if (word >= iterWords->size()) {
+    iterVersion = iterWords->size() * wordBits;
+    return;
+  } // End check for end of words
+  /* Drop the versions below iterVersion in the current word */
+  uint64_t bits = (*iterWords)[word] >> (iterVersion % wordBits);
+  if (bits) {
+    iterVersion += __builtin_ctzll(bits);
+    return;
+  } // End check for bits
+  for (++word; word < iterWords->size(); ++word) {
+    if ((*iterWords)[word]) {
+      iterVersion = word * wordBits + __builtin_ctzll((*iterWords)[word]);
+      return;
+    } // End check for word
+  }   // End loop for words
+  iterVersion = iterWords->size() * wordBits;
+} // End seekVersion
+
+bool Graph_Versions::insert(unsigned ver) {
+  std::size_t word = ver / wordBits;
+  if (word >= versionWords.size()) {
+    versionWords.resize(word + 1, 0);
+  } // End check for versionWords size
+  uint64_t bit = uint64_t(1) << (ver % wordBits);
+  if (versionWords[word] & bit) {
+    return false;
+  } // End check for bit
+  versionWords[word] |= bit;
+  ++versionCount;
+  return true;
+} // End insert
+
+std::string Graph_Versions::getPrintableVersions() const {
+  std::string printable;
+  printable.reserve(versionCount * 4);
+  for (auto ver : *this) {
+    if (!printable.empty()) {
+      printable.push_back(',');
+    } // End check for separator
+    printable.push_back('V');
+    printable.append(std::to_string(ver));
+  } // End loop for versions
+  return printable;
+} // End getPrintableVersions
+} // namespace hydrogen_framework
@@ -0,0 +1,122 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Graph_Versions Class: Compact set of graph versions
+ */
+#ifndef GRAPH_VERSIONS_H
+#define GRAPH_VERSIONS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+namespace hydrogen_framework {
+/**
+ * Graph_Versions Class: Set of graph versions kept as a dynamic bitset
+ * Membership tests and inserts are O(1). Iteration visits the versions in increasing order
+ */
+class Graph_Versions {
+public:
+  /**
+   * Iterator over the versions in the set
+   */
+  class const_iterator {
+  public:
+    /**
+     * Constructor
+     * Moves to the first version that is not smaller than ver
+     */
+    const_iterator(const std::vector<uint64_t> *words, unsigned ver) : iterWords(words), iterVersion(ver) {
+      seekVersion();
+    }
+
+    /**
+     * Return the current version
+     */
+    unsigned operator*() const { return iterVersion; }
+
+    /**
+     * Move to the next version in the set
+     */
+    const_iterator &operator++() {
+      ++iterVersion;
+      seekVersion();
+      return *this;
+    }
+
+    /**
+     * Overriding equal operation
+     */
+    bool operator==(const const_iterator &other) const { return iterVersion == other.iterVersion; }
+
+    /**
+     * Overriding not equal operation
+     */
+    bool operator!=(const const_iterator &other) const { return iterVersion != other.iterVersion; }
+
+  private:
+    /**
+     * Advance iterVersion to the next set bit or to the end of the words
+     */
+    void seekVersion();
+
+    const std::vector<uint64_t> *iterWords; /**< Words of the set */
+    unsigned iterVersion;                   /**< Current version */
+  };                                        // End const_iterator Class
+
+  /**
+   * Constructor
+   */
+  Graph_Versions() : versionCount(0) {}
+
+  /**
+   * Destructor
+   */
+  ~Graph_Versions() {}
+
+  /**
+   * Add ver to the set
+   * Returns FALSE if it was already present
+   */
+  bool insert(unsigned ver);
+
+  /**
+   * Return TRUE if ver is in the set
+   */
+  bool contains(unsigned ver) const {
+    std::size_t word = ver / wordBits;
+    return word < versionWords.size() && (versionWords[word] >> (ver % wordBits)) & 1;
+  }
+
+  /**
+   * Return number of versions in the set
+   */
+  unsigned size() const { return versionCount; }
+
+  /**
+   * Return TRUE if the set is empty
+   */
+  bool empty() const { return versionCount == 0; }
+
+  /**
+   * Return iterator to the smallest version
+   */
+  const_iterator begin() const { return const_iterator(&versionWords, 0); }
+
+  /**
+   * Return iterator past the largest version
+   */
+  const_iterator end() const { return const_iterator(&versionWords, versionWords.size() * wordBits); }
+
+  /**
+   * Return the versions as "V1,V2,..". Empty string for an empty set
+   */
+  std::string getPrintableVersions() const;
+
+  static const unsigned wordBits = 64; /**< Versions per word */
+
+private:
+  std::vector<uint64_t> versionWords; /**< Bit ver % wordBits of word ver / wordBits is set for every version */
+  unsigned versionCount;              /**< Number of versions in the set */
+};                                    // End Graph_Versions Class
+} // namespace hydrogen_framework
+#endif
@@ -0,0 +1,197 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Implementing Graph_Writer.hpp
+ */
+#include "Graph_Writer.hpp"
+#include <algorithm>
+#include <iostream>
+namespace hydrogen_framework {
+const std::size_t Graph_Writer::bufferSize;
+
+Graph_Writer::Graph_Writer() : writerMode(NONE), writerOpen(false), writerFailed(false) {
+#ifdef HYDROGEN_WITH_ZLIB
+  writerGzip = NULL;
+#endif
+#ifdef HYDROGEN_WITH_ZSTD
+  writerZstd = NULL;
+#endif
+} // End Graph_Writer
+
+Graph_Writer::~Graph_Writer() {
+  if (writerOpen) {
+    closeWriter();
+  } // End check for writerOpen
+} // End ~Graph_Writer
+
+bool Graph_Writer::isCompressionAvailable(writerCompression compression) {
+  switch (compression) {
+  case NONE:
+    return true;
+  case GZIP:
+#ifdef HYDROGEN_WITH_ZLIB
+    return true;
+#else
+    return false;
+#endif
+  case ZSTD:
+#ifdef HYDROGEN_WITH_ZSTD
+    return true;
+#else
+    return false;
+#endif
+  } // End switch for compression
+  return false;
+} // End isCompressionAvailable
+
+std::string Graph_Writer::getCompressionExtension(writerCompression compression) {
+  switch (compression) {
+  case NONE:
+    return "";
+  case GZIP:
+    return ".gz";
+  case ZSTD:
+    return ".zst";
+  } // End switch for compression
+  return "";
+} // End getCompressionExtension
+
+bool Graph_Writer::openWriter(std::string fileName, writerCompression compression) {
+  if (!isCompressionAvailable(compression)) {
+    std::cerr << "Compressed output was not enabled when building Hydrogen\n";
+    return false;
+  } // End check for isCompressionAvailable
+  fileName += getCompressionExtension(compression);
+  writerMode = compression;
+  writerFailed = false;
+  writerBuffer.clear();
+  writerBuffer.reserve(bufferSize);
+#ifdef HYDROGEN_WITH_ZLIB
+  if (writerMode == GZIP) {
+    writerGzip = gzopen(fileName.c_str(), "wb");
+    if (!writerGzip) {
+      std::cerr << "Unable to open " << fileName << " for writing\n";
+      return false;
+    } // End check for writerGzip
+    writerOpen = true;
+    return true;
+  } // End check for GZIP
+#endif
+  writerFile.open(fileName, std::ios::binary | std::ios::trunc);
+  if (!writerFile.is_open()) {
+    std::cerr << "Unable to open " << fileName << " for writing\n";
+    return false;
+  } // End check for writerFile
+#ifdef HYDROGEN_WITH_ZSTD
+  if (writerMode == ZSTD) {
+    writerZstd = ZSTD_createCCtx();
+    writerZstdOut.resize(ZSTD_CStreamOutSize());
+  } // End check for ZSTD
+#endif
+  writerOpen = true;
+  return true;
+} // End openWriter
+
+void Graph_Writer::write(const std::string &text) { write(text.data(), text.size()); } // End write
+
+void Graph_Writer::write(const char *data, std::size_t size) {
+  /* The buffer is flushed whenever it fills, so it always has room left here */
+  while (size > 0) {
+    std::size_t piece = std::min<std::size_t>(size, bufferSize - writerBuffer.size());
+    writerBuffer.append(data, piece);
+    data += piece;
+    size -= piece;
+    if (writerBuffer.size() >= bufferSize) {
+      flushBuffer();
+    } // End check for bufferSize
+  }   // End loop for size
+} // End write
+
+void Graph_Writer::flushBuffer() {
+  if (writerBuffer.empty()) {
+    return;
+  } // End check for empty buffer
+  if (writerMode == NONE) {
+    writerFile.write(writerBuffer.data(), writerBuffer.size());
+    writerFailed |= !writerFile;
+  } // End check for NONE
+#ifdef HYDROGEN_WITH_ZLIB
+  if (writerMode == GZIP) {
+    writerFailed |= gzwrite(writerGzip, writerBuffer.data(), writerBuffer.size()) != int(writerBuffer.size());
+  } // End check for GZIP
+#endif
+#ifdef HYDROGEN_WITH_ZSTD
+  if (writerMode == ZSTD) {
+    ZSTD_inBuffer input = {writerBuffer.data(), writerBuffer.size(), 0};
+    while (input.pos < input.size && !writerFailed) {
+      ZSTD_outBuffer output = {&writerZstdOut[0], writerZstdOut.size(), 0};
+      std::size_t status = ZSTD_compressStream2(writerZstd, &output, &input, ZSTD_e_continue);
+      writerFailed |= ZSTD_isError(status);
+      writerFile.write(writerZstdOut.data(), output.pos);
+      writerFailed |= !writerFile;
+    } // End loop for compressing
+  }   // End check for ZSTD
+#endif
+  writerBuffer.clear();
+} // End flushBuffer
+
+bool Graph_Writer::closeWriter() {
+  if (!writerOpen) {
+    return false;
+  } // End check for writerOpen
+  flushBuffer();
+#ifdef HYDROGEN_WITH_ZLIB
+  if (writerMode == GZIP) {
+    writerFailed |= gzclose(writerGzip) != Z_OK;
+    writerGzip = NULL;
+  } // End check for GZIP
+#endif
+#ifdef HYDROGEN_WITH_ZSTD
+  if (writerMode == ZSTD) {
+    /* Flush the frame epilogue */
+    ZSTD_inBuffer input = {NULL, 0, 0};
+    std::size_t remaining = 1;
+    while (remaining != 0 && !writerFailed) {
+      ZSTD_outBuffer output = {&writerZstdOut[0], writerZstdOut.size(), 0};
+      remaining = ZSTD_compressStream2(writerZstd, &output, &input, ZSTD_e_end);
+      writerFailed |= ZSTD_isError(remaining);
+      writerFile.write(writerZstdOut.data(), output.pos);
+      writerFailed |= !writerFile;
+    } // End loop for remaining
+    ZSTD_freeCCtx(writerZstd);
+    writerZstd = NULL;
+  } // End check for ZSTD
+#endif
+  if (writerFile.is_open()) {
+    writerFile.close();
+    writerFailed |= !writerFile;
+  } // End check for writerFile
+  writerOpen = false;
+  if (writerFailed) {
+    std::cerr << "Writing the output failed\n";
+  } // End check for writerFailed
+  return !writerFailed;
+} // End closeWriter
+
+void Graph_Writer::appendEscaped(std::string &out, const std::string &text) {
+  std::size_t start = 0;
+  for (std::size_t quote = text.find('"'); quote != std::string::npos; quote = text.find('"', start)) {
+    out.append(text, start, quote - start);
+    out.append("\\\"");
+    start = quote + 1;
+  } // End loop for quotes
+  out.append(text, start, std::string::npos);
+} // End appendEscaped
+
+void Graph_Writer::appendUnsigned(std::string &out, unsigned long long value) {
+  char digits[20];
+  int count = 0;
+  do {
+    digits[count++] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+  while (count > 0) {
+    out.push_back(digits[--count]);
+  } // End loop for digits
+} // End appendUnsigned
+} // namespace hydrogen_framework
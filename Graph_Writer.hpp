@@ -0,0 +1,105 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Graph_Writer Class: Buffered output of large text files with optional compression
+ */
+#ifndef GRAPH_WRITER_H
+#define GRAPH_WRITER_H
+
+#include <fstream>
+#include <string>
+#ifdef HYDROGEN_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HYDROGEN_WITH_ZSTD
+#include <zstd.h>
+#endif
+namespace hydrogen_framework {
+/**
+ * Graph_Writer Class: Collects text in a large buffer and writes it out in blocks
+ * gzip and zstd output are only available when built with HYDROGEN_WITH_ZLIB and HYDROGEN_WITH_ZSTD
+ * Also provides the formatting helpers used to build chunks of output without streams
+ */
+class Graph_Writer {
+public:
+  /**
+   * Enumeration for output compression
+   */
+  enum writerCompression { NONE, GZIP, ZSTD };
+
+  /**
+   * Constructor
+   */
+  Graph_Writer();
+
+  /**
+   * Destructor
+   * Closes the output if it is still open
+   */
+  ~Graph_Writer();
+
+  /**
+   * Open fileName for writing with the given compression. The extension of the compression is appended to fileName
+   * Returns FALSE if the file cannot be opened or the compression is not available
+   */
+  bool openWriter(std::string fileName, writerCompression compression);
+
+  /**
+   * Append text to the output
+   */
+  void write(const std::string &text);
+
+  /**
+   * Append size bytes from data to the output
+   * The bytes are taken in pieces of the buffer size, so large arrays are not copied whole
+   */
+  void write(const char *data, std::size_t size);
+
+  /**
+   * Write out the remaining buffer and close the output
+   * Returns FALSE if any write failed
+   */
+  bool closeWriter();
+
+  /**
+   * Return TRUE if this build can write the given compression
+   */
+  static bool isCompressionAvailable(writerCompression compression);
+
+  /**
+   * Return the file extension for the given compression. Empty for NONE
+   */
+  static std::string getCompressionExtension(writerCompression compression);
+
+  /**
+   * Append text to out with every double quote escaped by a backslash
+   */
+  static void appendEscaped(std::string &out, const std::string &text);
+
+  /**
+   * Append the decimal digits of value to out
+   */
+  static void appendUnsigned(std::string &out, unsigned long long value);
+
+private:
+  /**
+   * Hand the buffer to the output and empty it
+   */
+  void flushBuffer();
+
+  static const std::size_t bufferSize = 1 << 20; /**< Buffered bytes before they are written out */
+  writerCompression writerMode;                  /**< Compression of the open output */
+  bool writerOpen;                               /**< TRUE while the output is open */
+  bool writerFailed;                             /**< Set when a write fails */
+  std::string writerBuffer;                      /**< Text not yet written out */
+  std::ofstream writerFile;                      /**< Output for NONE and ZSTD */
+#ifdef HYDROGEN_WITH_ZLIB
+  gzFile writerGzip; /**< Output for GZIP */
+#endif
+#ifdef HYDROGEN_WITH_ZSTD
+  ZSTD_CCtx *writerZstd;     /**< Compression context for ZSTD */
+  std::string writerZstdOut; /**< Compressed bytes waiting for writerFile */
+#endif
+}; // End Graph_Writer Class
+} // namespace hydrogen_framework
+#endif
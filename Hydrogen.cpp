@@ -5,9 +5,12 @@
 #include "Diff_Mapping.hpp"
 #include "Get_Input.hpp"
 #include "Graph.hpp"
+#include "Graph_Exporter.hpp"
+#include "Graph_Snapshot.hpp"
 #include "Graph_Line.hpp"
 #include "MVICFG.hpp"
 #include "Module.hpp"
+#include "Verify_Cache.hpp"
 #include <chrono>
 
 using namespace hydrogen_framework;
@@ -20,13 +23,33 @@ int main(int argc, char *argv[]) {
   if (argc < 2) {
     std::cerr << "Insufficient arguments\n"
               << "The correct format is as follows:\n"
+              << "[--threads=<N>] [--pipeline=<N>] [--lazy] [--patience] [--no-verify] [--verify-cache=<File>] "
+              << "[--save-snapshot=<File>] [--append=<File>] [--compress=<gzip|zstd>] "
+              << "[--format=<dot|graphml|jsonl|edgelist>] [--output=<File>] "
               << "<Path-to-Module1> <Path-to-Module2> .. <Path-to-ModuleN> :: "
               << "<Path-to-file1-for-Module1> .. <Path-to-fileN-for-Module1> :: "
               << "<Path-to-file2-for-Module2> .. <Path-to-fileN-for-Module2> ..\n"
-              << "Note that '::' is the demarcation\n";
+              << "Note that '::' is the demarcation\n"
+              << "--threads sets the number of threads used for building ICFG and printing the MVICFG. Zero uses all "
+              << "hardware threads. At most four threads per hardware thread are used\n"
+              << "--pipeline prepares up to N upcoming versions in the background while merging\n"
+              << "--lazy parses each module only when needed and frees it once its version is merged\n"
+              << "--patience diffs the files around the lines unique to both versions. Faster on large files, but the "
+              << "line mapping may differ\n"
+              << "--no-verify skips verifying the modules\n"
+              << "--verify-cache skips verifying modules whose contents are recorded in File and records new ones\n"
+              << "--save-snapshot saves the MVICFG and the files of the last version into File\n"
+              << "--append merges the given modules into the MVICFG saved in File instead of building it from "
+              << "Module1. A single module is accepted\n"
+              << "--compress writes the MVICFG as MVICFG.dot.gz or MVICFG.dot.zst\n"
+              << "--format writes the MVICFG as DOT, GraphML, JSON lines or a binary edge list\n"
+              << "--output writes the MVICFG into File followed by the extension of the format. Defaults to MVICFG\n";
     return 1;
   } // End check for min argument
   Hydrogen framework;
+  if (!framework.parseOptions(argc, argv)) {
+    return 1;
+  } // End check for options
   if (!framework.validateInputs(argc, argv)) {
     return 2;
   } // End check for valid Input
@@ -34,44 +57,53 @@ int main(int argc, char *argv[]) {
     return 3;
   } // End check for processing Inputs
   std::list<Module *> mod = framework.getModules();
-  /* Create ICFG */
-  unsigned graphVersion = 1;
-  Module *firstMod = mod.front();
-  Graph *MVICFG = buildICFG(firstMod, graphVersion);
+  Graph *MVICFG = NULL;
+  if (!framework.getAppendFile().empty()) {
+    /* Resume from the snapshot. Its last version takes the place of the first module */
+    std::list<std::string> snapshotFiles;
+    std::list<std::string> snapshotContents;
+    MVICFG = loadSnapshot(framework.getAppendFile(), snapshotFiles, snapshotContents);
+    if (!MVICFG) {
+      return 3;
+    } // End check for MVICFG
+    /* The new version is diffed against the saved contents, not against whatever is at the paths now */
+    Module *snapshotMod = new Module();
+    auto iterContents = snapshotContents.begin();
+    for (const auto &iterFile : snapshotFiles) {
+      snapshotMod->setFileContents(iterFile, *iterContents++);
+    } // End loop for snapshotFiles
+    snapshotMod->setFiles(snapshotFiles);
+    mod.push_front(snapshotMod);
+  } else {
+    /* Create ICFG */
+    unsigned graphVersion = 1;
+    Module *firstMod = mod.front();
+    MVICFG = buildICFG(firstMod, graphVersion, framework.getThreads());
+    if (!MVICFG) {
+      return 3;
+    } // End check for MVICFG
+    releaseLazyModule(MVICFG, firstMod);
+  } // End check for getAppendFile
   /* Start timer */
   auto mvicfgStart = std::chrono::high_resolution_clock::now();
   /* Create MVICFG */
-  for (auto iterModule = mod.begin(), iterModuleEnd = mod.end(); iterModule != iterModuleEnd; ++iterModule) {
-    auto iterModuleNext = std::next(iterModule);
-    /* Proceed as long as there is a next module */
-    if (iterModuleNext != iterModuleEnd) {
-      /* Container for added and deleted MVICFG lines */
-      std::list<Graph_Line *> addedLines;
-      std::list<Graph_Line *> deletedLines;
-      std::map<Graph_Line *, Graph_Line *> matchedLines; /**<Map From ICFG Graph_Line to MVICFG Graph_Line */
-      std::list<Diff_Mapping> diffMap = generateLineMapping(*iterModule, *iterModuleNext);
-      Graph *ICFG = buildICFG(*iterModuleNext, ++graphVersion);
-      for (auto iter : diffMap) {
-        /* iter.printFileInfo(); */
-        std::list<Graph_Line *> iterAdd = addToMVICFG(MVICFG, ICFG, iter, graphVersion);
-        std::list<Graph_Line *> iterDel = deleteFromMVICFG(MVICFG, ICFG, iter, graphVersion);
-        std::map<Graph_Line *, Graph_Line *> iterMatch = matchedInMVICFG(MVICFG, ICFG, iter, graphVersion);
-        addedLines.insert(addedLines.end(), iterAdd.begin(), iterAdd.end());
-        deletedLines.insert(deletedLines.end(), iterDel.begin(), iterDel.end());
-        matchedLines.insert(iterMatch.begin(), iterMatch.end());
-      } // End loop for diffMap
-      /* Update Map Edges */
-      getEdgesForAddedLines(MVICFG, ICFG, addedLines, diffMap, graphVersion);
-      /* Update the matched lines to get new temporary variable mapping for old lines */
-      updateMVICFGVersion(MVICFG, addedLines, deletedLines, diffMap, graphVersion);
-      /* Update Map Version */
-      MVICFG->setGraphVersion(graphVersion);
-    } // End check for iterModuleEnd
-  } // End loop for Module
+  if (!mergeModules(MVICFG, mod, framework.getThreads(), framework.getPipelineDepth(), framework.isPatience())) {
+    return 4;
+  } // End check for mergeModules
+  if (framework.getVerifyCache()) {
+    framework.getVerifyCache()->saveCache();
+  } // End check for getVerifyCache
   /* Stop timer */
   auto mvicfgStop = std::chrono::high_resolution_clock::now();
   auto mvicfgBuildTime = std::chrono::duration_cast<std::chrono::milliseconds>(mvicfgStop - mvicfgStart);
-  MVICFG->printGraph("MVICFG");
+  if (!exportGraph(MVICFG, framework.getOutput(), framework.getFormat(), framework.getCompression(),
+                   framework.getThreads())) {
+    return 5;
+  } // End check for exportGraph
+  if (!framework.getSnapshotFile().empty() &&
+      !saveSnapshot(MVICFG, mod.back()->getFiles(), framework.getSnapshotFile())) {
+    return 6;
+  } // End check for getSnapshotFile
   std::cout << "Finished Building MVICFG in " << mvicfgBuildTime.count() << "ms\n";
   /* Write output to file */
   std::ofstream rFile("Result.txt", std::ios::trunc);
@@ -4,6 +4,7 @@
  * Implementing MVICFG.hpp
  */
 #include "MVICFG.hpp"
+#include "Bounded_Queue.hpp"
 #include "Diff_Mapping.hpp"
 #include "Graph.hpp"
 #include "Graph_Edge.hpp"
@@ -11,157 +12,191 @@
 #include "Graph_Instruction.hpp"
 #include "Graph_Line.hpp"
 #include "Module.hpp"
+#include "Source_File.hpp"
+#include "Thread_Pool.hpp"
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 namespace hydrogen_framework {
-Graph *buildICFG(Module *mod, unsigned graphVersion) {
+Graph *buildICFG(Module *mod, unsigned graphVersion, unsigned threads) {
+  if (!mod->loadModule()) {
+    return NULL;
+  } // End check for loadModule
   std::unique_ptr<llvm::Module> &modPtr = mod->getPtr();
   Graph *ICFG = new Graph(graphVersion);
+  std::vector<llvm::Function *> functions;
   for (llvm::Function &F : (*modPtr)) {
-    std::string funcName;
-    Graph_Function *funcGraph = new Graph_Function(ICFG->getNextID());
-    if (F.hasName()) {
-      funcName = F.getName();
-    } else {
-      funcName = "Unknown_Function";
-    } // End check for function name
-    funcGraph->setFunctionName(funcName);
-    Graph_Line *currentLineGraph = new Graph_Line(graphVersion);
-    for (llvm::BasicBlock &BB : F) {
-      for (llvm::Instruction &I : BB) {
-        unsigned int DILocLine = 0;
-        std::string DIFile = "Unknown_File";
-        getLocationInfo(I, DILocLine, DIFile);
-        /* Attach the line to current line if no debug information is found */
-        if (DILocLine == 0) {
-          DILocLine = currentLineGraph->getLineNumber(graphVersion);
-        } // End check for DILocLine
-        /* Create new Graph_Line container whenever new DILocLine is encountered */
-        if (DILocLine != currentLineGraph->getLineNumber(graphVersion)) {
-          if (!currentLineGraph->isLineInstructionEmpty()) {
-            funcGraph->pushFunctionLines(currentLineGraph);
-            ICFG->addSeqEdges(currentLineGraph);
-          } // End check for isLineInstructionEmpty
-          currentLineGraph = new Graph_Line(graphVersion);
-        } // End check for continuation for current line
-        if (!funcGraph->isFunctionFileSet()) {
-          funcGraph->setFunctionFile(DIFile);
-        } // End check for isFunctionFileSet
-        currentLineGraph->setLineNumber(graphVersion, DILocLine);
-        std::string instLabel;
-        llvm::raw_string_ostream rInstLabel(instLabel);
-        I.print(rInstLabel);
-        Graph_Instruction *currentInstGraph = new Graph_Instruction();
-        currentInstGraph->setInstructionLabel(instLabel);
-        currentInstGraph->setInstructionID(ICFG->getNextID());
-        llvm::Instruction *iTmp = &I;
-        currentInstGraph->setInstructionPtr(iTmp);
-        currentLineGraph->pushLineInstruction(currentInstGraph);
-      } // End loop for BasicBlock
-    }   // End loop for Function
-    if (!currentLineGraph->isLineInstructionEmpty()) {
-      funcGraph->pushFunctionLines(currentLineGraph);
-      ICFG->addSeqEdges(currentLineGraph);
-    } // End check for isLineInstructionEmpty
-    if (!funcGraph->isFunctionLinesEmpty()) {
-      ICFG->pushGraphFunction(funcGraph);
-      ICFG->addVirtualNodes(funcGraph);
-    } // End check for isFunctionLinesEmpty
-  }   // End loop for Module
+    functions.push_back(&F);
+  } // End loop for Module
+  /* Function containers do not depend on each other till call edges are added */
+  std::vector<Graph_Function *> funcGraphs(functions.size(), NULL);
+  /* Every function gets its own arena, so workers never share one */
+  std::vector<Graph_Arena> funcArenas(functions.size());
+  Thread_Pool pool(threads);
+  pool.parallelFor(functions.size(), [&](size_t index) {
+    funcGraphs[index] = buildFunctionGraph(*functions[index], graphVersion, funcArenas[index]);
+  });
+  /* Merge in module order so that IDs and edges do not depend on the number of threads */
+  for (std::size_t index = 0; index < funcGraphs.size(); ++index) {
+    ICFG->getArena().adoptArena(funcArenas[index]);
+    mergeFunctionGraph(ICFG, funcGraphs[index]);
+  } // End loop for funcGraphs
   ICFG->addBranchEdges();
   ICFG->addFunctionCallEdges();
   /* ICFG->printGraph("Graph_" + std::to_string(graphVersion)); */
   return ICFG;
 } // End buildICFG
 
-std::list<Diff_Mapping> generateLineMapping(Module *firstMod, Module *secondMod) {
-  std::list<Diff_Mapping> diffMap;
-  std::list<std::string> processedFiles;
-  /* Process files from first module */
-  for (auto iterFile : (firstMod)->getFiles()) {
-    std::list<std::string> nextModuleFiles = (secondMod)->getFiles();
-    auto fileMatch = std::find_if(std::begin(nextModuleFiles), std::end(nextModuleFiles), [=](std::string f) {
-      return (boost::filesystem::path(f).filename() == boost::filesystem::path(iterFile).filename());
-    });
-    Diff_Mapping::sequence ALines, BLines;
-    if (fileMatch != nextModuleFiles.end()) {
-      /* Matching file exist */
-      processedFiles.push_back(boost::filesystem::path(iterFile).filename().c_str());
-      std::ifstream Aifs(iterFile.c_str());
-      std::ifstream Bifs((*fileMatch).c_str());
-      Diff_Mapping::elem buf;
-      while (getline(Aifs, buf)) {
-        ALines.push_back(buf);
-      } // End loop for Aifs
-      while (getline(Bifs, buf)) {
-        BLines.push_back(buf);
-      } // End loop for Bifs
-    } else {
-      /* File no longer exist */
-      processedFiles.push_back(boost::filesystem::path(iterFile).filename().c_str());
-      std::ifstream Aifs(iterFile.c_str());
-      Diff_Mapping::elem buf;
-      while (getline(Aifs, buf)) {
-        ALines.push_back(buf);
-      } // End loop for Aifs
-    }   // End check for nextModuleFiles
-    Diff_Util diff(ALines, BLines);
-    diff.compose();
-    Diff_Ses s = diff.getSes();
-    Diff_Mapping file(boost::filesystem::path(iterFile).filename().c_str());
-    file.putMapping(s.getSequence());
-    /* file.printMapping(); */
-    diffMap.push_back(file);
-  } // End loop for first module file processing
-  /* Check for new files in next module */
-  for (auto iterFile : (secondMod)->getFiles()) {
-    auto fileMatch = std::find_if(std::begin(processedFiles), std::end(processedFiles),
-                                  [=](std::string f) { return (f == boost::filesystem::path(iterFile).filename()); });
-    if (fileMatch == processedFiles.end()) {
-      /* New file exist */
-      processedFiles.push_back(boost::filesystem::path(iterFile).filename().c_str());
-      Diff_Mapping::sequence ALines, BLines;
-      std::ifstream Bifs(iterFile.c_str());
-      Diff_Mapping::elem buf;
-      while (getline(Bifs, buf)) {
-        BLines.push_back(buf);
-      } // End loop for Bifs
-      Diff_Util diff(ALines, BLines);
-      diff.compose();
-      Diff_Ses s = diff.getSes();
-      Diff_Mapping file(boost::filesystem::path(iterFile).filename().c_str());
-      file.putMapping(s.getSequence());
-      /* file.printMapping(); */
-      diffMap.push_back(file);
+Graph_Function *buildFunctionGraph(llvm::Function &F, unsigned graphVersion, Graph_Arena &arena) {
+  std::string funcName;
+  Graph_Function *funcGraph = arena.newFunction(0);
+  if (F.hasName()) {
+    funcName = F.getName();
+  } else {
+    funcName = "Unknown_Function";
+  } // End check for function name
+  funcGraph->setFunctionName(funcName);
+  Graph_Line *currentLineGraph = arena.newLine(graphVersion);
+  for (llvm::BasicBlock &BB : F) {
+    for (llvm::Instruction &I : BB) {
+      unsigned int DILocLine = 0;
+      std::string DIFile = "Unknown_File";
+      getLocationInfo(I, DILocLine, DIFile);
+      /* Attach the line to current line if no debug information is found */
+      if (DILocLine == 0) {
+        DILocLine = currentLineGraph->getLineNumber(graphVersion);
+      } // End check for DILocLine
+      /* Create new Graph_Line container whenever new DILocLine is encountered */
+      if (DILocLine != currentLineGraph->getLineNumber(graphVersion)) {
+        if (!currentLineGraph->isLineInstructionEmpty()) {
+          funcGraph->pushFunctionLines(currentLineGraph);
+        } // End check for isLineInstructionEmpty
+        currentLineGraph = arena.newLine(graphVersion);
+      } // End check for continuation for current line
+      if (!funcGraph->isFunctionFileSet()) {
+        funcGraph->setFunctionFile(DIFile);
+      } // End check for isFunctionFileSet
+      currentLineGraph->setLineNumber(graphVersion, DILocLine);
+      /* The label is printed from the LLVM Instruction when it is needed */
+      Graph_Instruction *currentInstGraph = arena.newInstruction();
+      llvm::Instruction *iTmp = &I;
+      currentInstGraph->setInstructionPtr(iTmp);
+      currentLineGraph->pushLineInstruction(currentInstGraph);
+    } // End loop for BasicBlock
+  }   // End loop for Function
+  if (!currentLineGraph->isLineInstructionEmpty()) {
+    funcGraph->pushFunctionLines(currentLineGraph);
+  } // End check for isLineInstructionEmpty
+  return funcGraph;
+} // End buildFunctionGraph
+
+void mergeFunctionGraph(Graph *ICFG, Graph_Function *funcGraph) {
+  funcGraph->setFunctionID(ICFG->getNextID());
+  for (auto line : funcGraph->getFunctionLines()) {
+    for (auto inst : line->getLineInstructions()) {
+      inst->setInstructionID(ICFG->getNextID());
+    } // End loop for inst
+    ICFG->addSeqEdges(line);
+  } // End loop for line
+  if (!funcGraph->isFunctionLinesEmpty()) {
+    ICFG->pushGraphFunction(funcGraph);
+    ICFG->addVirtualNodes(funcGraph);
+  } // End check for isFunctionLinesEmpty
+} // End mergeFunctionGraph
+
+/**
+ * Structure for a file diffed by generateLineMapping
+ */
+typedef struct filePair {
+  std::string name;     /**< File name the Diff_Mapping is made for */
+  std::string fromFile; /**< Path of the file in the first module. Empty for new files */
+  std::string toFile;   /**< Path of the file in the second module. Empty for removed files */
+} filePair;
+
+std::list<Diff_Mapping> generateLineMapping(Module *firstMod, Module *secondMod, bool anchored, unsigned threads) {
+  /* Files are paired by name. The first file of the second module with a name is the one matched */
+  std::unordered_map<std::string, std::string> secondFiles;
+  for (const auto &iterFile : secondMod->getFiles()) {
+    secondFiles.insert(std::make_pair(boost::filesystem::path(iterFile).filename().string(), iterFile));
+  } // End loop for second module files
+  std::vector<filePair> pairs;
+  std::unordered_set<std::string> processedFiles;
+  /* Files from first module, matched or no longer existing */
+  for (const auto &iterFile : firstMod->getFiles()) {
+    filePair pair;
+    pair.name = boost::filesystem::path(iterFile).filename().string();
+    pair.fromFile = iterFile;
+    auto fileMatch = secondFiles.find(pair.name);
+    if (fileMatch != secondFiles.end()) {
+      pair.toFile = fileMatch->second;
+    } // End check for secondFiles
+    processedFiles.insert(pair.name);
+    pairs.push_back(pair);
+  } // End loop for first module files
+  /* New files in next module */
+  for (const auto &iterFile : secondMod->getFiles()) {
+    filePair pair;
+    pair.name = boost::filesystem::path(iterFile).filename().string();
+    pair.toFile = iterFile;
+    if (processedFiles.insert(pair.name).second) {
+      pairs.push_back(pair);
     } // End check for processedFiles
-  }   // End loop for second module file processing
-  return diffMap;
+  }   // End loop for second module files
+  /* Every file is diffed on its own. Mappings keep the order of pairs whatever the number of threads */
+  std::vector<Diff_Mapping> mappings;
+  mappings.reserve(pairs.size());
+  for (const auto &pair : pairs) {
+    mappings.push_back(Diff_Mapping(pair.name));
+  } // End loop for pairs
+  Thread_Pool pool(threads);
+  pool.parallelFor(pairs.size(), [&](size_t index) {
+    /* Lines point into the mapped files, which are needed only till Diff_Util has interned them */
+    Source_File AFile(pairs[index].fromFile);
+    Source_File BFile(pairs[index].toFile);
+    /* Contents kept by a module are the ones it was built from, whatever is at the path now */
+    const std::string *AContents = firstMod->getFileContents(pairs[index].fromFile);
+    const std::string *BContents = secondMod->getFileContents(pairs[index].toFile);
+    if (AContents) {
+      AFile.setContents(*AContents);
+    } else if (!pairs[index].fromFile.empty()) {
+      AFile.mapFile();
+    } // End check for fromFile
+    if (BContents) {
+      BFile.setContents(*BContents);
+    } else if (!pairs[index].toFile.empty()) {
+      BFile.mapFile();
+    } // End check for toFile
+    /* Most files do not change between versions and need neither a diff nor a line mapping */
+    if (!pairs[index].fromFile.empty() && !pairs[index].toFile.empty() && AFile.isSameContents(BFile)) {
+      mappings[index].putIdentity();
+      return;
+    } // End check for identical contents
+    Diff_Util diff(AFile.splitLines(), BFile.splitLines(), anchored);
+    AFile.unmapFile();
+    BFile.unmapFile();
+    diff.compose();
+    mappings[index].putMapping(diff.getSes().getSequence());
+    /* mappings[index].printMapping(); */
+  });
+  return std::list<Diff_Mapping>(mappings.begin(), mappings.end());
 } // End generateLineMapping
 
 std::list<Graph_Line *> getGraphLinesGivenLine(Graph *graph, long long lineNo, std::string fileName) {
   std::list<Graph_Line *> graphLines;
-  bool foundLine = false;
-  for (auto func : graph->getGraphFunctions()) {
-    /* Matching with correct diff File */
-    if (func->getFunctionFile() == fileName) {
-      for (auto line : func->getFunctionLines()) {
-        /* Matching line of diff */
-        if (line->getLineNumber(graph->getGraphVersion()) == lineNo) {
-          graphLines.push_back(line);
-          foundLine = true;
-        } // End check for lineNo
-      }   // End loop for line
-      /* Same line cannot be spread across functions. Hence stop search if at least one line found */
-      if (foundLine) {
-        return graphLines;
-      } // End check for foundLine
-    }   // End check for fileName
-  }     // End loop for Functions
+  const std::vector<Graph_Line *> &indexedLines = graph->getGraphLines(fileName, graph->getGraphVersion(), lineNo);
+  for (auto line : indexedLines) {
+    /* Same line cannot be spread across functions. Hence only keep lines from the first function found */
+    if (line->getGraphFunction() == indexedLines.front()->getGraphFunction()) {
+      graphLines.push_back(line);
+    } // End check for function
+  }   // End loop for line
   return graphLines;
 } // End getGraphLinesGivenLine
 
 std::list<Graph_Line *> getPredGivenGraphLine(Graph_Line *line) {
   std::list<Graph_Line *> pred;
   Graph_Instruction *frontInst = line->getLineInstructions().front();
-  std::list<Graph_Edge *> edges = frontInst->getInstructionEdges();
+  const std::vector<Graph_Edge *> &edges = frontInst->getInstructionEdges();
   for (auto iter : edges) {
     if (iter->getEdgeTo() == frontInst) {
       pred.push_back(iter->getEdgeFrom()->getGraphLine());
@@ -173,7 +208,7 @@ std::list<Graph_Line *> getPredGivenGraphLine(Graph_Line *line) {
 std::list<Graph_Line *> getSuccGivenGraphLine(Graph_Line *line) {
   std::list<Graph_Line *> succ;
   Graph_Instruction *backInst = line->getLineInstructions().back();
-  std::list<Graph_Edge *> edges = backInst->getInstructionEdges();
+  const std::vector<Graph_Edge *> &edges = backInst->getInstructionEdges();
   for (auto iter : edges) {
     if (iter->getEdgeFrom() == backInst) {
       succ.push_back(iter->getEdgeTo()->getGraphLine());
@@ -182,43 +217,13 @@ std::list<Graph_Line *> getSuccGivenGraphLine(Graph_Line *line) {
   return succ;
 } // End getSuccGivenGraphLine
 
-std::string getGraphLineInstructionsAsString(Graph_Line *line) {
-  std::string lineString;
-  /* Iterate through the Graph_Line and make a string representation of the Instruction OpCode */
-  for (auto inst : line->getLineInstructions()) {
-    /* If Ptr is not found, then it won't be present in the other version as well */
-    if (inst->getInstructionPtr() != NULL) {
-      lineString.append(inst->getInstructionPtr()->getOpcodeName()).append(" ");
-    } // End check for Instruction Ptr
-  }   // End loop for Graph_Line
-  if (!lineString.empty()) {
-    lineString.pop_back();
-  } // End check for empty string before remove trailing space
-  return lineString;
-} // End getGraphLineInstructionsAsString
-
-Graph_Line *resolveMatchedLinesWithNoExtactStringMatch(std::list<Graph_Line *> matchedLines, std::string lineFromString,
-                                                       unsigned int graphVersion) {
-  int minDiff = std::numeric_limits<int>::max();
+Graph_Line *resolveMatchedLinesWithNoExactOpcodeMatch(const std::list<Graph_Line *> &matchedLines, Graph_Line *lineFrom,
+                                                     unsigned int graphVersion) {
+  unsigned minDiff = std::numeric_limits<unsigned>::max();
   Graph_Line *tmp = NULL;
   for (auto line : matchedLines) {
-    /* First remove matched OpCodes */
-    std::string lineToString = getGraphLineInstructionsAsString(line);
-    std::size_t pos = lineToString.find(lineFromString);
-    if (pos != std::string::npos) {
-      lineToString.erase(pos, lineFromString.length());
-      boost::trim(lineToString);
-    } // End check for match in lineToString
-    /* Get the OpCodes remaining */
-    int countOpCode = 0;
-    if (!lineToString.empty()) {
-      countOpCode = 1;
-      for (auto ch : lineToString) {
-        if (ch == ' ') {
-          ++countOpCode;
-        } // End check for space
-      }   // End loop for counting space
-    }     // End check for empty lineToString after removing matches
+    /* Count the OpCodes to change for an exact match */
+    unsigned countOpCode = lineFrom->getOpcodeDistance(line);
     if (countOpCode < minDiff) {
       minDiff = countOpCode;
       tmp = line;
@@ -228,9 +233,9 @@ Graph_Line *resolveMatchedLinesWithNoExtactStringMatch(std::list<Graph_Line *> m
     std::cerr << "The heuristically matched line for " << tmp->getLineNumber(graphVersion) << "might be incorrect\n";
   } // End check for minDiff
   return tmp;
-} // End resolveMatchedLinesWithNoExtactStringMatch
+} // End resolveMatchedLinesWithNoExactOpcodeMatch
 
-Graph_Line *findMatchedLine(Graph_Line *t, Graph *matchTo, Graph *matchFrom, Diff_Mapping diff) {
+Graph_Line *findMatchedLine(Graph_Line *t, Graph *matchTo, Graph *matchFrom, const Diff_Mapping &diff) {
   /* Extra check to ensure correct diff File */
   if (diff.getFileName() != t->getGraphFunction()->getFunctionFile()) {
     std::cerr << "findMatchedLine is using wrong diff File\n";
@@ -264,36 +269,28 @@ Graph_Line *findMatchedLine(Graph_Line *t, Graph *matchTo, Graph *matchFrom, Dif
     }   // End check for matchTo > matchFrom
   }     // End check for isVirtualNodeLineNumber
   if (lineTo != std::numeric_limits<unsigned>::max()) {
-    for (auto func : matchTo->getGraphFunctions()) {
-      if (func->getFunctionFile() == t->getGraphFunction()->getFunctionFile()) {
-        if (func->getFunctionName() == t->getGraphFunction()->getFunctionName()) {
-          std::list<Graph_Line *> matchedLines;
-          for (auto line : func->getFunctionLines()) {
-            if (lineTo == line->getLineNumber(matchTo->getGraphVersion())) {
-              std::string lineToString = getGraphLineInstructionsAsString(line);
-              std::string lineFromString = getGraphLineInstructionsAsString(t);
-              if (lineToString == lineFromString) {
-                return line;
-              } else {
-                matchedLines.push_back(line);
-              } // End check for lineTo and lineFrom string
-            }   // End check for matching line number
-          }     // End loop for lines
-          /* If there is a match at this point heuristically match it rather than return NULL */
-          if (!matchedLines.empty()) {
-            /* If only one match is there, then we don't have to work much */
-            if (matchedLines.size() == 1) {
-              return matchedLines.front();
-            } else {
-              std::string lineFromString = getGraphLineInstructionsAsString(t);
-              return resolveMatchedLinesWithNoExtactStringMatch(matchedLines, lineFromString,
-                                                                matchTo->getGraphVersion());
-            } // End check for matchedLines size
-          }   // End check for empty matchedLines
-        }     // End check for Function name check
-      }       // End check for File name
-    }         // End loop for functions
-  }           // End check for virtual node check
+    std::string fileName = t->getGraphFunction()->getFunctionFile();
+    std::string funcName = t->getGraphFunction()->getFunctionName();
+    std::list<Graph_Line *> matchedLines;
+    for (auto line : matchTo->getGraphLines(fileName, matchTo->getGraphVersion(), lineTo)) {
+      if (line->getGraphFunction()->getFunctionName() == funcName) {
+        if (line->isSameOpcodes(t)) {
+          return line;
+        } else {
+          matchedLines.push_back(line);
+        } // End check for lineTo and lineFrom OpCodes
+      }   // End check for Function name check
+    }     // End loop for lines
+    /* If there is a match at this point heuristically match it rather than return NULL */
+    if (!matchedLines.empty()) {
+      /* If only one match is there, then we don't have to work much */
+      if (matchedLines.size() == 1) {
+        return matchedLines.front();
+      } else {
+        return resolveMatchedLinesWithNoExactOpcodeMatch(matchedLines, t, matchTo->getGraphVersion());
+      } // End check for matchedLines size
+    }   // End check for empty matchedLines
+  }     // End check for virtual node check
   return NULL;
 } // End findMatchedLine
 
@@ -313,7 +310,7 @@ Graph_Edge *getEdge(Graph_Instruction *fromNode, Graph_Instruction *toNode, Grap
 } // End getEdge
 
 Graph_Edge *getInBetweenEdge(Graph_Line *fromLine, Graph_Line *toLine) {
-  std::list<Graph_Instruction *> fromLineInstructions = fromLine->getLineInstructions();
+  const std::vector<Graph_Instruction *> &fromLineInstructions = fromLine->getLineInstructions();
   for (auto fromLineInstIter = fromLineInstructions.rbegin(); fromLineInstIter != fromLineInstructions.rend();
        ++fromLineInstIter) {
     Graph_Instruction *fromLineInst = *fromLineInstIter;
@@ -327,27 +324,21 @@ Graph_Edge *getInBetweenEdge(Graph_Line *fromLine, Graph_Line *toLine) {
   return NULL;
 } // End getInBetweenEdge
 
-Graph_Line *getNewlyAdded(Graph *MVICFG, Graph *ICFG, Graph_Line *newLine, Diff_Mapping diff) {
-  std::list<long long> addedLines = diff.getAddedLines();
-  auto findAdd = std::find_if(std::begin(addedLines), std::end(addedLines),
-                              [=](long long no) { return (no == newLine->getLineNumber(ICFG->getGraphVersion())); });
-  if (findAdd != addedLines.end()) {
-    for (auto func : MVICFG->getGraphFunctions()) {
-      /* Compare line number within same file */
-      if (func->getFunctionFile() == newLine->getGraphFunction()->getFunctionFile()) {
-        for (auto line : func->getFunctionLines()) {
-          if (newLine->getLineNumber(ICFG->getGraphVersion()) == line->getLineNumber(ICFG->getGraphVersion())) {
-            return line;
-          } // End check for line and newLine numbers
-        }   // End loop for line
-      }     // End check for function file
-    }       // End loop for function
-  }         // End check for addLines.end
+Graph_Line *getNewlyAdded(Graph *MVICFG, Graph *ICFG, Graph_Line *newLine, const Diff_Mapping &diff) {
+  if (diff.isAddedLine(newLine->getLineNumber(ICFG->getGraphVersion()))) {
+    /* Compare line number within same file */
+    const std::vector<Graph_Line *> &lines =
+        MVICFG->getGraphLines(newLine->getGraphFunction()->getFunctionFile(), ICFG->getGraphVersion(),
+                              newLine->getLineNumber(ICFG->getGraphVersion()));
+    if (!lines.empty()) {
+      return lines.front();
+    } // End check for lines
+  }   // End check for addLines.end
   return NULL;
 } // End getNewlyAdded
 
-std::list<Graph_Line *> addToMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping diff, unsigned Version) {
-  std::list<long long> addedLines = diff.getAddedLines();
+std::list<Graph_Line *> addToMVICFG(Graph *MVICFG, Graph *ICFG, const Diff_Mapping &diff, unsigned Version) {
+  const std::vector<long long> &addedLines = diff.getAddedLines();
   std::string fileName = diff.getFileName();
   std::list<Graph_Line *> N;
   std::list<Graph_Line *> icfgN;
@@ -363,7 +354,7 @@ std::list<Graph_Line *> addToMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping dif
     for (auto addedLine : addedGraphLines) {
       Graph_Function *func = addedLine->getGraphFunction();
       /* Get corresponding MVICFG Graph_Function */
-      std::list<Graph_Function *> mvicfgFunctions = MVICFG->getGraphFunctions();
+      const std::list<Graph_Function *> &mvicfgFunctions = MVICFG->getGraphFunctions();
       auto findMvicfgFunc =
           std::find_if(std::begin(mvicfgFunctions), std::end(mvicfgFunctions), [=](Graph_Function *mvicfgfunc) {
             return mvicfgfunc->getFunctionName() == func->getFunctionName();
@@ -371,20 +362,19 @@ std::list<Graph_Line *> addToMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping dif
       /* Create new one if it doesn't exist */
       Graph_Function *mvicfgFunc;
       if (findMvicfgFunc == mvicfgFunctions.end()) {
-        mvicfgFunc = new Graph_Function(MVICFG->getNextID());
-        Graph_Function *mvicfgFunc = new Graph_Function(MVICFG->getNextID());
+        mvicfgFunc = MVICFG->getArena().newFunction(MVICFG->getNextID());
+        Graph_Function *mvicfgFunc = MVICFG->getArena().newFunction(MVICFG->getNextID());
         mvicfgFunc->setFunctionName(func->getFunctionName());
         mvicfgFunc->setFunctionFile(func->getFunctionFile());
       } else {
         mvicfgFunc = *findMvicfgFunc;
       } // End check for findMvicfgFunc
       /* Iterating through addedLine and adding instructions to MVICFG */
-      Graph_Line *newLine = new Graph_Line(ICFG->getGraphVersion());
+      Graph_Line *newLine = MVICFG->getArena().newLine(ICFG->getGraphVersion());
       newLine->setLineNumber(MVICFG->getGraphVersion(), 0);
       newLine->setLineNumber(ICFG->getGraphVersion(), addedLine->getLineNumber(ICFG->getGraphVersion()));
       for (auto inst : addedLine->getLineInstructions()) {
-        Graph_Instruction *newInstruction = new Graph_Instruction();
-        newInstruction->setInstructionLabel(inst->getInstructionLabel());
+        Graph_Instruction *newInstruction = MVICFG->getArena().newInstruction();
         newInstruction->setInstructionID(MVICFG->getNextID());
         newInstruction->setInstructionPtr(inst->getInstructionPtr());
         newLine->pushLineInstruction(newInstruction);
@@ -445,7 +435,7 @@ std::list<Graph_Line *> addToMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping dif
                       edgeType = Graph_Edge::MVICFG_ADD;
                     } // End check for foundEdge
                   }   // End check for getEdgeType
-                  Graph_Edge *newEdge = new Graph_Edge(tDashInst, nInst, edgeType, Version);
+                  Graph_Edge *newEdge = MVICFG->getArena().newEdge(tDashInst, nInst, edgeType, Version);
                   MVICFG->addEdge(tDashInst, nInst, newEdge);
                 } else {
                   checkEdge->pushEdgeVersions(Version);
@@ -477,7 +467,7 @@ std::list<Graph_Line *> addToMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping dif
                       edgeType = Graph_Edge::MVICFG_ADD;
                     } // End check for foundEdge
                   }   // End check for edgeType
-                  Graph_Edge *newEdge = new Graph_Edge(nInst, tDashInst, edgeType, Version);
+                  Graph_Edge *newEdge = MVICFG->getArena().newEdge(nInst, tDashInst, edgeType, Version);
                   MVICFG->addEdge(nInst, tDashInst, newEdge);
                 } else {
                   checkEdge->pushEdgeVersions(Version);
@@ -497,21 +487,18 @@ std::list<Graph_Line *> addToMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping dif
 } // End addToMVICFG
 
 Graph_Instruction *getMatchedInstructionFromGraph(Graph *graphToMatch, Graph_Instruction *instToMatch) {
+  if (instToMatch->getInstructionPtr() != NULL) {
+    /* Non virtual nodes are resolved through the instruction index of the Graph */
+    return graphToMatch->findMatchedInstruction(instToMatch->getInstructionPtr());
+  } // End check for instToMatch
   for (auto func : graphToMatch->getGraphFunctions()) {
     for (auto line : func->getFunctionLines()) {
-      std::list<Graph_Instruction *> lineInstList = line->getLineInstructions();
-      std::_List_iterator<Graph_Instruction *> findInst;
-      if (instToMatch->getInstructionPtr() == NULL) {
-        /* This is a virtual node and they always share their line numbers */
-        unsigned instToLineNumber = instToMatch->getGraphLine()->getLineNumber(graphToMatch->getGraphVersion());
-        findInst = std::find_if(std::begin(lineInstList), std::end(lineInstList), [=](Graph_Instruction *inst) {
-          return (inst->getGraphLine()->getLineNumber(graphToMatch->getGraphVersion() == instToLineNumber));
-        });
-      } else {
-        findInst = std::find_if(std::begin(lineInstList), std::end(lineInstList), [=](Graph_Instruction *inst) {
-          return (inst->getInstructionPtr() == instToMatch->getInstructionPtr());
-        });
-      } // End check for instToMatch
+      const std::vector<Graph_Instruction *> &lineInstList = line->getLineInstructions();
+      /* This is a virtual node and they always share their line numbers */
+      unsigned instToLineNumber = instToMatch->getGraphLine()->getLineNumber(graphToMatch->getGraphVersion());
+      auto findInst = std::find_if(std::begin(lineInstList), std::end(lineInstList), [=](Graph_Instruction *inst) {
+        return (inst->getGraphLine()->getLineNumber(graphToMatch->getGraphVersion() == instToLineNumber));
+      });
       if (findInst != lineInstList.end()) {
         return *findInst;
       } // End check for findInst
@@ -520,8 +507,8 @@ Graph_Instruction *getMatchedInstructionFromGraph(Graph *graphToMatch, Graph_Ins
   return NULL;
 } // End getMatchedInstructionFromGraph
 
-void getEdgesForAddedLines(Graph *MVICFG, Graph *ICFG, std::list<Graph_Line *> addedLines,
-                           std::list<Diff_Mapping> diffMap, unsigned Version) {
+void getEdgesForAddedLines(Graph *MVICFG, Graph *ICFG, const std::list<Graph_Line *> &addedLines,
+                           const std::list<Diff_Mapping> &diffMap, unsigned Version) {
   for (auto line : addedLines) {
     for (auto lineInst : line->getLineInstructions()) {
       Graph_Instruction *lineDashInst = getMatchedInstructionFromGraph(ICFG, lineInst);
@@ -545,7 +532,7 @@ void getEdgesForAddedLines(Graph *MVICFG, Graph *ICFG, std::list<Graph_Line *> a
         } // End check for to
         Graph_Edge *checkEdge = getEdge(from, to, edgeDash->getEdgeType());
         if (!checkEdge) {
-          Graph_Edge *newEdge = new Graph_Edge(from, to, edgeDash->getEdgeType(), ICFG->getGraphVersion());
+          Graph_Edge *newEdge = MVICFG->getArena().newEdge(from, to, edgeDash->getEdgeType(), ICFG->getGraphVersion());
           MVICFG->addEdge(from, to, newEdge);
         } // End check for checkEdge
       }   // End loop for adding edges
@@ -553,8 +540,8 @@ void getEdgesForAddedLines(Graph *MVICFG, Graph *ICFG, std::list<Graph_Line *> a
   }       // End loop for line
 } // End getEdgesForAddedLines
 
-std::list<Graph_Line *> deleteFromMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping diff, unsigned Version) {
-  std::list<long long> deletedLines = diff.getDeletedLines();
+std::list<Graph_Line *> deleteFromMVICFG(Graph *MVICFG, Graph *ICFG, const Diff_Mapping &diff, unsigned Version) {
+  const std::vector<long long> &deletedLines = diff.getDeletedLines();
   std::string fileName = diff.getFileName();
   std::list<Graph_Line *> N;
   /* Identify all deleted lines */
@@ -644,7 +631,7 @@ std::list<Graph_Line *> deleteFromMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mappin
                                 edgeType = Graph_Edge::MVICFG_DEL;
                               } // End check for foundEdge
                             }   // End check for getEdgeType
-                            Graph_Edge *newEdge = new Graph_Edge(mInst, nInst, edgeType, Version);
+                            Graph_Edge *newEdge = MVICFG->getArena().newEdge(mInst, nInst, edgeType, Version);
                             MVICFG->addEdge(mInst, nInst, newEdge);
                           } // End check for checkEdge
                         } else if (findMSucc != succDash.end()) {
@@ -674,7 +661,7 @@ std::list<Graph_Line *> deleteFromMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mappin
                                 edgeType = Graph_Edge::MVICFG_DEL;
                               } // End check for foundEdge
                             }   // End check for getEdgeType
-                            Graph_Edge *newEdge = new Graph_Edge(nInst, mInst, edgeType, Version);
+                            Graph_Edge *newEdge = MVICFG->getArena().newEdge(nInst, mInst, edgeType, Version);
                             MVICFG->addEdge(nInst, mInst, newEdge);
                           } // End check for checkEdge
                         }   // End check for Predecessors and Successors
@@ -700,8 +687,9 @@ std::list<Graph_Line *> deleteFromMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mappin
   return N;
 } // End deleteFromMVICFG
 
-std::map<Graph_Line *, Graph_Line *> matchedInMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping diff, unsigned Version) {
-  std::map<long long, long long> matchedLines = diff.getMatchedLines();
+std::map<Graph_Line *, Graph_Line *> matchedInMVICFG(Graph *MVICFG, Graph *ICFG, const Diff_Mapping &diff,
+                                                     unsigned Version) {
+  const std::vector<std::pair<long long, long long>> &matchedLines = diff.getMatchedLines();
   std::string fileName = diff.getFileName();
   std::map<Graph_Line *, Graph_Line *> matchedGraphLines;
   std::list<Graph_Line *> mvicfgM;
@@ -811,13 +799,22 @@ std::map<Graph_Line *, Graph_Line *> matchedInMVICFG(Graph *MVICFG, Graph *ICFG,
   return matchedGraphLines;
 } // End matchedInMVICFG
 
-void updateMVICFGVersion(Graph *MVICFG, std::list<Graph_Line *> addedLines, std::list<Graph_Line *> deletedLines,
-                         std::list<Diff_Mapping> diffMap, unsigned Version) {
+void updateMVICFGVersion(Graph *MVICFG, const std::list<Graph_Line *> &addedLines,
+                         const std::list<Graph_Line *> &deletedLines, const std::list<Diff_Mapping> &diffMap,
+                         unsigned Version) {
   /* Update Graph_Line information */
   for (auto func : MVICFG->getGraphFunctions()) {
     auto findDiff = std::find_if(std::begin(diffMap), std::end(diffMap),
-                                 [=](Diff_Mapping d) { return (d.getFileName() == func->getFunctionFile()); });
-    if (findDiff != diffMap.end()) {
+                                 [=](const Diff_Mapping &d) { return (d.getFileName() == func->getFunctionFile()); });
+    if (findDiff != diffMap.end() && findDiff->isIdentical()) {
+      /* Lines of an unchanged file keep their line numbers */
+      for (auto line : func->getFunctionLines()) {
+        unsigned oldLineNumber = line->getLineNumber(MVICFG->getGraphVersion());
+        if (oldLineNumber != 0) {
+          line->setLineNumber(Version, oldLineNumber);
+        } // End check for oldLineNumber
+      }   // End loop for line
+    } else if (findDiff != diffMap.end()) {
       for (auto line : func->getFunctionLines()) {
         auto findInAdd = std::find_if(std::begin(addedLines), std::end(addedLines),
                                       [=](Graph_Line *addLine) { return (addLine == line); });
@@ -887,4 +884,118 @@ void updateMVICFGVersion(Graph *MVICFG, std::list<Graph_Line *> addedLines, std:
     }       // End check for edgeFromInst
   }         // End loop for updating Graph_Edge information
 } // End updateMVICFGVersion
+
+std::list<Graph_Line *> mergeICFG(Graph *MVICFG, Graph *ICFG, const std::list<Diff_Mapping> &diffMap,
+                                  unsigned Version) {
+  /* Container for added and deleted MVICFG lines */
+  std::list<Graph_Line *> addedLines;
+  std::list<Graph_Line *> deletedLines;
+  std::map<Graph_Line *, Graph_Line *> matchedLines; /**<Map From ICFG Graph_Line to MVICFG Graph_Line */
+  for (const auto &iter : diffMap) {
+    /* iter.printFileInfo(); */
+    if (iter.isIdentical()) {
+      /* Nothing is added or deleted. Lines and edges are carried over by updateMVICFGVersion */
+      continue;
+    } // End check for isIdentical
+    std::list<Graph_Line *> iterAdd = addToMVICFG(MVICFG, ICFG, iter, Version);
+    std::list<Graph_Line *> iterDel = deleteFromMVICFG(MVICFG, ICFG, iter, Version);
+    std::map<Graph_Line *, Graph_Line *> iterMatch = matchedInMVICFG(MVICFG, ICFG, iter, Version);
+    addedLines.insert(addedLines.end(), iterAdd.begin(), iterAdd.end());
+    deletedLines.insert(deletedLines.end(), iterDel.begin(), iterDel.end());
+    matchedLines.insert(iterMatch.begin(), iterMatch.end());
+  } // End loop for diffMap
+  /* Update Map Edges */
+  getEdgesForAddedLines(MVICFG, ICFG, addedLines, diffMap, Version);
+  /* Update the matched lines to get new temporary variable mapping for old lines */
+  updateMVICFGVersion(MVICFG, addedLines, deletedLines, diffMap, Version);
+  /* Update Map Version */
+  MVICFG->setGraphVersion(Version);
+  return addedLines;
+} // End mergeICFG
+
+/**
+ * Structure for the work done ahead of merging a version into MVICFG
+ */
+typedef struct versionUpdate {
+  unsigned version;                /**< Graph version of ICFG */
+  Module *mod;                     /**< Module of the version */
+  Graph *ICFG;                     /**< ICFG of the version. NULL if it could not be built */
+  std::list<Diff_Mapping> diffMap; /**< Line mappings from the previous version */
+} versionUpdate;
+
+void releaseLazyModule(Graph *graph, Module *mod) {
+  if (mod->isModuleLazy()) {
+    graph->detachInstructions();
+    mod->releaseModule();
+  } // End check for isModuleLazy
+} // End releaseLazyModule
+
+void releaseLazyModule(Graph *graph, Module *mod, const std::list<Graph_Line *> &attachedLines) {
+  if (mod->isModuleLazy()) {
+    graph->detachInstructions(attachedLines);
+    mod->releaseModule();
+  } // End check for isModuleLazy
+} // End releaseLazyModule
+
+bool mergeModules(Graph *MVICFG, std::list<Module *> mods, unsigned threads, unsigned pipelineDepth, bool anchored) {
+  unsigned graphVersion = MVICFG->getGraphVersion();
+  if (pipelineDepth == 0) {
+    for (auto iterModule = mods.begin(), iterModuleEnd = mods.end(); iterModule != iterModuleEnd; ++iterModule) {
+      auto iterModuleNext = std::next(iterModule);
+      /* Proceed as long as there is a next module */
+      if (iterModuleNext != iterModuleEnd) {
+        std::list<Diff_Mapping> diffMap = generateLineMapping(*iterModule, *iterModuleNext, anchored, threads);
+        Graph *ICFG = buildICFG(*iterModuleNext, ++graphVersion, threads);
+        if (!ICFG) {
+          return false;
+        } // End check for ICFG
+        std::list<Graph_Line *> addedLines = mergeICFG(MVICFG, ICFG, diffMap, graphVersion);
+        /* MVICFG keeps no references into ICFG once merged */
+        delete ICFG;
+        /* Detaching prints the labels, so MVICFG must let go of the module before it is freed */
+        releaseLazyModule(MVICFG, *iterModuleNext, addedLines);
+      } // End check for iterModuleEnd
+    }   // End loop for Module
+    return true;
+  } // End check for pipelineDepth
+  /* Diffing and building ICFG of a version do not depend on merging the earlier versions */
+  Bounded_Queue<versionUpdate *> updates(pipelineDepth);
+  std::thread producer([&]() {
+    unsigned updateVersion = graphVersion;
+    for (auto iterModule = mods.begin(), iterModuleEnd = mods.end(); iterModule != iterModuleEnd; ++iterModule) {
+      auto iterModuleNext = std::next(iterModule);
+      if (iterModuleNext != iterModuleEnd) {
+        versionUpdate *update = new versionUpdate();
+        update->diffMap = generateLineMapping(*iterModule, *iterModuleNext, anchored, threads);
+        update->version = ++updateVersion;
+        update->mod = *iterModuleNext;
+        update->ICFG = buildICFG(update->mod, update->version, threads);
+        /* The update belongs to the merging thread once pushed */
+        bool built = (update->ICFG != NULL);
+        updates.push(update);
+        /* Merging stops at the first failed version */
+        if (!built) {
+          break;
+        } // End check for built
+      } // End check for iterModuleEnd
+    }   // End loop for Module
+  });
+  bool merged = true;
+  for (std::size_t iter = 1; iter < mods.size(); ++iter) {
+    versionUpdate *update = updates.pop();
+    if (update->ICFG) {
+      std::list<Graph_Line *> addedLines = mergeICFG(MVICFG, update->ICFG, update->diffMap, update->version);
+      delete update->ICFG;
+      releaseLazyModule(MVICFG, update->mod, addedLines);
+    } else {
+      merged = false;
+    } // End check for ICFG
+    delete update;
+    if (!merged) {
+      break;
+    } // End check for merged
+  } // End loop for merging updates
+  producer.join();
+  return merged;
+} // End mergeModules
 } // namespace hydrogen_framework
@@ -10,6 +10,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
 #include <list>
+#include <llvm/IR/Function.h>
 #include <llvm/IR/Instruction.h>
 #include <map>
 #include <set>
@@ -18,20 +19,43 @@ namespace hydrogen_framework {
 /* Forward declaration */
 class Diff_Mapping;
 class Graph;
+class Graph_Arena;
 class Graph_Edge;
+class Graph_Function;
 class Graph_Instruction;
 class Graph_Line;
 class Module;
 
 /**
  * Build ICFG for the given module
+ * The Graph_Function of each LLVM Function is built on one of the given number of threads
+ * The resulting ICFG is the same for any number of threads
+ * Parses a lazy module if it is not loaded yet. Returns NULL if the parsing fails
  */
-Graph *buildICFG(Module *mod, unsigned graphVersion);
+Graph *buildICFG(Module *mod, unsigned graphVersion, unsigned threads);
+
+/**
+ * Build the Graph_Function with its Graph_Line and Graph_Instruction for the given LLVM Function
+ * The containers are created in arena, which must be adopted by the ICFG before merging the Graph_Function
+ * IDs and edges are not assigned. Safe to call concurrently for different functions and arenas
+ */
+Graph_Function *buildFunctionGraph(llvm::Function &F, unsigned graphVersion, Graph_Arena &arena);
+
+/**
+ * Assign IDs and sequential edges for the Graph_Function built by buildFunctionGraph and add it to the ICFG
+ * Graph_Functions without any Graph_Line are not added
+ */
+void mergeFunctionGraph(Graph *ICFG, Graph_Function *funcGraph);
 
 /**
  * Generate Line Mappings between two modules
+ * Files are paired by their name and each pair is diffed on one of the given number of threads
+ * Files are read from their path unless their module keeps their contents
+ * Pairs with the same contents are not diffed and get an identical Diff_Mapping
+ * Mappings are in the order of the files of the first module followed by the new files of the second module
+ * When anchored, files are diffed around the lines unique to both versions of the file
  */
-std::list<Diff_Mapping> generateLineMapping(Module *firstMod, Module *secondMod);
+std::list<Diff_Mapping> generateLineMapping(Module *firstMod, Module *secondMod, bool anchored, unsigned threads);
 
 /**
  * Get Graph_Line(s) from given source line
@@ -49,27 +73,22 @@ std::list<Graph_Line *> getPredGivenGraphLine(Graph_Line *line);
  */
 std::list<Graph_Line *> getSuccGivenGraphLine(Graph_Line *line);
 
-/**
- * Get the OpCode of the Instructions in a Graph_Line as String in the order in which they appear
- * Returns empty string if none of the Graph_Instruction had Instruction_Ptr
- */
-std::string getGraphLineInstructionsAsString(Graph_Line *line);
-
 /**
  * Heuristically try to find the closest Graph_Line match from a list of potential Graph_Line matches
- * when no exact match is found using getGraphLineInstructionsAsString
- * Currently will throw an warning if heuristic skips more than 2 OpCode to match the lines
+ * when none of them has the same OpCodes as lineFrom
+ * Picks the first Graph_Line with the smallest edit distance between its OpCodes and the ones of lineFrom
+ * Currently will throw an warning if heuristic changes more than 2 OpCode to match the lines
  * Returns NULL if no heuristic match is found
  */
-Graph_Line *resolveMatchedLinesWithNoExtactStringMatch(std::list<Graph_Line *> matchedLines, std::string lineFromString,
-                                                       unsigned int graphVersion);
+Graph_Line *resolveMatchedLinesWithNoExactOpcodeMatch(const std::list<Graph_Line *> &matchedLines, Graph_Line *lineFrom,
+                                                     unsigned int graphVersion);
 
 /**
  * Find matched Node
  * Returns NULL if no match found
  * Always make sure to check that the Graph_Line is from the diff being used
  */
-Graph_Line *findMatchedLine(Graph_Line *t, Graph *matchTo, Graph *matchFrom, Diff_Mapping diff);
+Graph_Line *findMatchedLine(Graph_Line *t, Graph *matchTo, Graph *matchFrom, const Diff_Mapping &diff);
 
 /**
  * Get the edge between two given nodes
@@ -90,12 +109,12 @@ Graph_Edge *getInBetweenEdge(Graph_Line *fromLine, Graph_Line *toLine);
  * Used only when findMatchedLine fails to retrieve the same
  * Returns NULL if no such line is found
  */
-Graph_Line *getNewlyAdded(Graph *MVICFG, Graph *ICFG, Graph_Line *newLine, Diff_Mapping diff);
+Graph_Line *getNewlyAdded(Graph *MVICFG, Graph *ICFG, Graph_Line *newLine, const Diff_Mapping &diff);
 
 /**
  * Add nodes to MVICFG and returns the added MVICFG lines
  */
-std::list<Graph_Line *> addToMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping diff, unsigned Version);
+std::list<Graph_Line *> addToMVICFG(Graph *MVICFG, Graph *ICFG, const Diff_Mapping &diff, unsigned Version);
 
 /**
  * Get matching Graph_Instruction from given Graph given a Graph_Instruction using LLVM PTR
@@ -106,23 +125,58 @@ Graph_Instruction *getMatchedInstructionFromGraph(Graph *graphToMatch, Graph_Ins
 /**
  * Import edges from ICFG instruction for added Graph_Line
  */
-void getEdgesForAddedLines(Graph *MVICFG, Graph *ICFG, std::list<Graph_Line *> addedLines,
-                           std::list<Diff_Mapping> diffMap, unsigned Version);
+void getEdgesForAddedLines(Graph *MVICFG, Graph *ICFG, const std::list<Graph_Line *> &addedLines,
+                           const std::list<Diff_Mapping> &diffMap, unsigned Version);
 
 /**
  * Mark deleted nodes in MVICFG and returns the deleted MVICFG lines
  */
-std::list<Graph_Line *> deleteFromMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping diff, unsigned Version);
+std::list<Graph_Line *> deleteFromMVICFG(Graph *MVICFG, Graph *ICFG, const Diff_Mapping &diff, unsigned Version);
 
 /**
  * Returns the corresponding matched Graph_Line in MVICFG from ICFG
  */
-std::map<Graph_Line *, Graph_Line *> matchedInMVICFG(Graph *MVICFG, Graph *ICFG, Diff_Mapping diff, unsigned Version);
+std::map<Graph_Line *, Graph_Line *> matchedInMVICFG(Graph *MVICFG, Graph *ICFG, const Diff_Mapping &diff,
+                                                     unsigned Version);
 
 /**
  * Update the Edge and Node information for MVICFG
  */
-void updateMVICFGVersion(Graph *MVICFG, std::list<Graph_Line *> addedLines, std::list<Graph_Line *> deletedLines,
-                         std::list<Diff_Mapping> diffMap, unsigned Version);
+void updateMVICFGVersion(Graph *MVICFG, const std::list<Graph_Line *> &addedLines,
+                         const std::list<Graph_Line *> &deletedLines, const std::list<Diff_Mapping> &diffMap,
+                         unsigned Version);
+
+/**
+ * Merge the ICFG of the given Version into MVICFG using the line mappings from the previous version
+ * Moves MVICFG to the given Version
+ * Returns the Graph_Lines added to MVICFG. Only their Graph_Instructions refer to the LLVM Module of ICFG
+ */
+std::list<Graph_Line *> mergeICFG(Graph *MVICFG, Graph *ICFG, const std::list<Diff_Mapping> &diffMap,
+                                  unsigned Version);
+
+/**
+ * Detach the Graph from the LLVM Instructions of a lazy module and free the module
+ * Every Graph_Instruction of the Graph is visited, as needed for a Graph built from the module
+ * Does nothing for modules that are not lazy
+ */
+void releaseLazyModule(Graph *graph, Module *mod);
+
+/**
+ * Detach the given Graph_Lines, the only ones referring to a lazy module, and free the module
+ * Used after merging, with the Graph_Lines returned by mergeICFG
+ * Does nothing for modules that are not lazy
+ */
+void releaseLazyModule(Graph *graph, Module *mod, const std::list<Graph_Line *> &attachedLines);
+
+/**
+ * Merge every module after the first into MVICFG, which must be the ICFG of the first module
+ * With pipelineDepth of zero every version is diffed, built and merged in turn
+ * Otherwise, a background thread diffs and builds up to pipelineDepth upcoming versions while the
+ * calling thread merges them in order
+ * Lazy modules are freed once their version is merged, and so is the ICFG of every version
+ * anchored and threads are passed on to generateLineMapping
+ * Returns FALSE if the ICFG of any module could not be built
+ */
+bool mergeModules(Graph *MVICFG, std::list<Module *> mods, unsigned threads, unsigned pipelineDepth, bool anchored);
 } // namespace hydrogen_framework
 #endif
@@ -4,25 +4,67 @@
  * Implementing Module.hpp
  */
 #include "Module.hpp"
+#include "Verify_Cache.hpp"
 namespace hydrogen_framework {
 bool Module::setModule(int ver, std::string file) {
   modVersion = ver;
-  llvm::StringRef modulePath(file);
+  modLazy = false;
+  modPath = file;
+  return loadModule();
+} // End setModule
+
+void Module::setLazyModule(int ver, std::string file) {
+  modVersion = ver;
+  modLazy = true;
+  modPath = file;
+} // End setLazyModule
+
+bool Module::loadModule() {
+  if (isModuleLoaded()) {
+    return true;
+  } // End check for isModuleLoaded
+  std::string file = modPath;
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> fileBuffer = llvm::MemoryBuffer::getFile(file);
+  if (!fileBuffer) {
+    std::cerr << "Error in reading the " << file << "\n";
+    return false;
+  } // End check for fileBuffer
+  std::unique_ptr<llvm::MemoryBuffer> buffer = std::move(fileBuffer.get());
+  /* Cached contents need no verification */
+  std::string contentHash;
+  bool verify = modVerify;
+  if (verify && modVerifyCache) {
+    contentHash = Verify_Cache::getContentHash(buffer->getBuffer());
+    verify = !modVerifyCache->isVerified(contentHash);
+  } // End check for modVerifyCache
+  modContext.reset(new llvm::LLVMContext());
+  /* Bitcode is read in full as well, since the ICFG covers the body of every function */
   llvm::SMDiagnostic error;
-  modPtr = llvm::parseIRFile(modulePath, error, modContext);
+  modPtr = llvm::parseIR(buffer->getMemBufferRef(), error, *modContext);
   /* Parsing Error handling */
   if (!modPtr) {
-    std::string errorMessage;
-    llvm::raw_string_ostream output(errorMessage);
-    /* error.print("Error in parsing the file ", output); */
     std::cerr << "Error in parsing the " << file << "\n";
+    releaseModule();
     return false;
   } // End check for modPtr
+  if (!verify) {
+    return true;
+  } // End check for verify
   /* Verifying Module */
   if (llvm::verifyModule(*modPtr, &llvm::errs()) != 0) {
     std::cerr << "Error in verifying the Module : " << file << "\n";
+    releaseModule();
     return false;
   } // End check for verifyModule
+  if (modVerifyCache) {
+    modVerifyCache->insertVerified(contentHash);
+  } // End check for modVerifyCache
   return true;
-} // End setModule
+} // End loadModule
+
+void Module::releaseModule() {
+  /* The module has to go before the context that owns its types and constants */
+  modPtr.reset();
+  modContext.reset();
+} // End releaseModule
 } // namespace hydrogen_framework
@@ -12,10 +12,15 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/IRReader/IRReader.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/SourceMgr.h>
 #include <llvm/Support/raw_ostream.h>
+#include <unordered_map>
 
 namespace hydrogen_framework {
+/* Forward declaration */
+class Verify_Cache;
+
 /**
  * LLVM Module class: Hold the LLVM modules and associated files
  */
@@ -25,7 +30,7 @@ public:
    * Constructor for module class
    * Set version to zero
    */
-  Module() { modVersion = 0; }
+  Module() : modVersion(0), modLazy(false), modVerify(true), modVerifyCache(NULL) {}
 
   /**
    * Destructor
@@ -38,11 +43,62 @@ public:
    */
   bool setModule(int ver, std::string file);
 
+  /**
+   * Set module version and path without parsing the LLVM IR
+   * The module is parsed by loadModule when first needed and can be freed again by releaseModule
+   */
+  void setLazyModule(int ver, std::string file);
+
+  /**
+   * Set how loadModule verifies the module. Must be called before the module is loaded
+   * With verify set to FALSE the module is not verified. Otherwise, contents found in cache are not verified again
+   * cache can be NULL
+   */
+  void setVerification(bool verify, Verify_Cache *cache) {
+    modVerify = verify;
+    modVerifyCache = cache;
+  }
+
+  /**
+   * Parse the LLVM IR or bitcode at modPath into a fresh LLVM Context if it is not already loaded
+   * Returns FALSE if LLVM IR parsing error is found
+   */
+  bool loadModule();
+
+  /**
+   * Free the LLVM Module and its LLVM Context
+   * Any llvm::Instruction taken from the module is invalid afterwards
+   */
+  void releaseModule();
+
+  /**
+   * Return TRUE if modPtr holds a parsed LLVM Module
+   */
+  bool isModuleLoaded() { return modPtr != nullptr; }
+
+  /**
+   * Return modLazy
+   */
+  bool isModuleLazy() { return modLazy; }
+
   /**
    * Set modFiles by swapping out with the incoming list of files
    */
   void setFiles(std::list<std::string> file) { modFiles.swap(file); }
 
+  /**
+   * Keep contents in memory as the contents of file, which is then not read from its path
+   */
+  void setFileContents(std::string file, std::string contents) { modFileContents[file].swap(contents); }
+
+  /**
+   * Return the contents kept for file. NULL if file is to be read from its path
+   */
+  const std::string *getFileContents(const std::string &file) const {
+    auto findContents = modFileContents.find(file);
+    return findContents != modFileContents.end() ? &findContents->second : NULL;
+  }
+
   /**
    * Return modVersion
    */
@@ -56,13 +112,22 @@ public:
   /**
    * Return modFiles;
    */
-  std::list<std::string> getFiles() { return modFiles; }
+  const std::list<std::string> &getFiles() const { return modFiles; }
 
 private:
-  int modVersion;                       /**< Module Version */
-  llvm::LLVMContext modContext;         /**< LLVM Module Context */
-  std::unique_ptr<llvm::Module> modPtr; /**< LLVM Module Pointer */
-  std::list<std::string> modFiles;      /**< Source files for the LLVM Module */
-};                                      // End module class
+  int modVersion;                                  /**< Module Version */
+  bool modLazy;                                    /**< TRUE if the module is parsed only when needed */
+  std::string modPath;                             /**< Path to the LLVM IR */
+  bool modVerify;                                  /**< TRUE if the module is verified when loaded */
+  Verify_Cache *modVerifyCache;                    /**< Hashes of already verified contents. Can be NULL */
+  std::unique_ptr<llvm::LLVMContext> modContext;   /**< LLVM Module Context. Declared before modPtr to outlive it */
+  std::unique_ptr<llvm::Module> modPtr;            /**< LLVM Module Pointer */
+  std::list<std::string> modFiles;                 /**< Source files for the LLVM Module */
+
+  /**
+   * Contents of modFiles kept in memory, by path
+   */
+  std::unordered_map<std::string, std::string> modFileContents;
+}; // End module class
 } // namespace hydrogen_framework
 #endif
@@ -0,0 +1,86 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Implementing Source_File.hpp
+ */
+#include "Source_File.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+namespace hydrogen_framework {
+bool Source_File::mapFile() {
+  unmapFile();
+  int fd = open(sourceName.c_str(), O_RDONLY);
+  if (fd == -1) {
+    std::cerr << "Unable to open " << sourceName << "\n";
+    return false;
+  } // End check for fd
+  struct stat buffer;
+  if (fstat(fd, &buffer) == -1) {
+    std::cerr << "Unable to read " << sourceName << "\n";
+    close(fd);
+    return false;
+  } // End check for fstat
+  if (buffer.st_size == 0) {
+    /* Empty files cannot be mapped and have no lines */
+    close(fd);
+    return true;
+  } // End check for st_size
+  std::size_t size = buffer.st_size;
+  void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    std::cerr << "Unable to map " << sourceName << "\n";
+    return false;
+  } // End check for mapping
+  /* Lines are read once from start to end */
+  madvise(mapping, size, MADV_SEQUENTIAL);
+  sourceMapping = mapping;
+  sourceData = static_cast<const char *>(mapping);
+  sourceSize = size;
+  return true;
+} // End mapFile
+
+void Source_File::unmapFile() {
+  if (sourceMapping) {
+    munmap(sourceMapping, sourceSize);
+  } // End check for sourceMapping
+  sourceMapping = NULL;
+  sourceData = NULL;
+  sourceSize = 0;
+} // End unmapFile
+
+void Source_File::setContents(const std::string &contents) {
+  unmapFile();
+  sourceData = contents.data();
+  sourceSize = contents.size();
+} // End setContents
+
+bool Source_File::isSameContents(const Source_File &other) const {
+  if (sourceSize != other.sourceSize) {
+    return false;
+  } // End check for sourceSize
+  return sourceSize == 0 || std::memcmp(sourceData, other.sourceData, sourceSize) == 0;
+} // End isSameContents
+
+Diff_Vars::sequence Source_File::splitLines() const {
+  Diff_Vars::sequence lines;
+  const char *lineStart = sourceData;
+  const char *end = sourceData + sourceSize;
+  while (lineStart < end) {
+    const char *lineEnd = static_cast<const char *>(std::memchr(lineStart, '\n', end - lineStart));
+    if (!lineEnd) {
+      lineEnd = end;
+    } // End check for last line
+    Diff_Vars::elem line;
+    line.data = lineStart;
+    line.length = lineEnd - lineStart;
+    lines.push_back(line);
+    lineStart = lineEnd + 1;
+  } // End loop for lines
+  return lines;
+} // End splitLines
+} // namespace hydrogen_framework
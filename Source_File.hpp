@@ -0,0 +1,87 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Source_File Class: Reading source files for the diff without copying them
+ */
+#ifndef SOURCE_FILE_H
+#define SOURCE_FILE_H
+
+#include "Diff_Util.hpp"
+#include <cstddef>
+#include <string>
+namespace hydrogen_framework {
+/**
+ * Source_File Class: Source file mapped into memory, or contents already in memory
+ * The lines returned by splitLines point into the contents and are valid till the Source_File is destroyed
+ */
+class Source_File {
+public:
+  /**
+   * Constructor
+   */
+  Source_File(std::string name) : sourceName(name), sourceData(NULL), sourceSize(0), sourceMapping(NULL) {}
+
+  /**
+   * Destructor
+   */
+  ~Source_File() { unmapFile(); }
+
+  /**
+   * Map sourceName into memory
+   * Returns FALSE if the file cannot be opened or mapped, leaving the Source_File empty
+   */
+  bool mapFile();
+
+  /**
+   * Unmap the file. The Source_File is empty afterwards
+   */
+  void unmapFile();
+
+  /**
+   * Use contents instead of mapping sourceName. contents must outlive the Source_File or the next mapFile
+   */
+  void setContents(const std::string &contents);
+
+  /**
+   * Return a copy of the contents
+   */
+  std::string getContents() const { return sourceData ? std::string(sourceData, sourceSize) : std::string(); }
+
+  /**
+   * Return TRUE if other has the same contents
+   */
+  bool isSameContents(const Source_File &other) const;
+
+  /**
+   * Return the lines of the file without their line breaks. A last line without a line break is kept
+   */
+  Diff_Vars::sequence splitLines() const;
+
+  /**
+   * Return sourceName
+   */
+  const std::string &getName() const { return sourceName; }
+
+  /**
+   * Return sourceSize
+   */
+  std::size_t getSize() const { return sourceSize; }
+
+private:
+  std::string sourceName; /**< Path of the file */
+  const char *sourceData; /**< Contents of the file. NULL if empty or not mapped */
+  std::size_t sourceSize; /**< Size of the contents */
+  void *sourceMapping;    /**< Mapping to unmap. NULL if not mapped */
+
+  /**
+   * Copying would unmap the file twice
+   */
+  Source_File(const Source_File &other);
+
+  /**
+   * Copying would unmap the file twice
+   */
+  Source_File &operator=(const Source_File &other);
+}; // End Source_File Class
+} // namespace hydrogen_framework
+#endif
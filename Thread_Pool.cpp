@@ -0,0 +1,32 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Implementing Thread_Pool.hpp
+ */
+#include "Thread_Pool.hpp"
+namespace hydrogen_framework {
+void Thread_Pool::parallelFor(size_t count, std::function<void(size_t)> job) {
+  if (poolThreads == 1 || count < 2) {
+    for (size_t index = 0; index < count; ++index) {
+      job(index);
+    } // End loop for index
+    return;
+  } // End check for single thread
+  std::atomic<size_t> nextIndex(0);
+  auto worker = [&]() {
+    for (size_t index = nextIndex++; index < count; index = nextIndex++) {
+      job(index);
+    } // End loop for claimed index
+  };
+  size_t workerCount = std::min(static_cast<size_t>(poolThreads), count);
+  std::vector<std::thread> workers;
+  /* The calling thread also works, so spawn one less */
+  for (size_t iter = 1; iter < workerCount; ++iter) {
+    workers.push_back(std::thread(worker));
+  } // End loop for spawning workers
+  worker();
+  for (auto &thread : workers) {
+    thread.join();
+  } // End loop for joining workers
+} // End parallelFor
+} // namespace hydrogen_framework
@@ -0,0 +1,51 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Thread_Pool Class: Running independent jobs on multiple threads
+ */
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+namespace hydrogen_framework {
+/**
+ * Thread_Pool Class: Distributes indexed jobs over a fixed number of worker threads
+ */
+class Thread_Pool {
+public:
+  /**
+   * Constructor
+   * Zero threads means one thread per hardware thread
+   */
+  Thread_Pool(unsigned threads) : poolThreads(threads) {
+    if (poolThreads == 0) {
+      poolThreads = std::max(1u, std::thread::hardware_concurrency());
+    } // End check for poolThreads
+  }
+
+  /**
+   * Destructor
+   */
+  ~Thread_Pool() {}
+
+  /**
+   * Run job for every index in [0, count) and return once all of them are finished
+   * Idle workers claim the next unclaimed index, so uneven jobs stay balanced across workers
+   * Runs on the calling thread when only one thread is requested
+   */
+  void parallelFor(size_t count, std::function<void(size_t)> job);
+
+  /**
+   * Return poolThreads
+   */
+  unsigned getThreads() { return poolThreads; }
+
+private:
+  unsigned poolThreads; /**< Number of worker threads */
+};                      // End Thread_Pool Class
+} // namespace hydrogen_framework
+#endif
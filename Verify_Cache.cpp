@@ -0,0 +1,52 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Implementing Verify_Cache.hpp
+ */
+#include "Verify_Cache.hpp"
+#include <fstream>
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Support/MD5.h>
+namespace hydrogen_framework {
+void Verify_Cache::loadCache() {
+  std::ifstream cache(cacheFile);
+  std::string hash;
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  while (std::getline(cache, hash)) {
+    if (!hash.empty()) {
+      cacheHashes.insert(hash);
+    } // End check for empty line
+  }   // End loop for cache
+} // End loadCache
+
+bool Verify_Cache::saveCache() {
+  std::ofstream cache(cacheFile, std::ios::trunc);
+  if (!cache.is_open()) {
+    std::cerr << "Unable to open " << cacheFile << " for writing the verification cache\n";
+    return false;
+  } // End check for cache
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  for (auto hash : cacheHashes) {
+    cache << hash << "\n";
+  } // End loop for cacheHashes
+  return true;
+} // End saveCache
+
+std::string Verify_Cache::getContentHash(llvm::StringRef contents) {
+  llvm::MD5 hasher;
+  llvm::MD5::MD5Result result;
+  hasher.update(contents);
+  hasher.final(result);
+  return std::string(result.digest().str());
+} // End getContentHash
+
+bool Verify_Cache::isVerified(std::string hash) {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  return cacheHashes.find(hash) != cacheHashes.end();
+} // End isVerified
+
+void Verify_Cache::insertVerified(std::string hash) {
+  std::lock_guard<std::mutex> lock(cacheMutex);
+  cacheHashes.insert(hash);
+} // End insertVerified
+} // namespace hydrogen_framework
@@ -0,0 +1,62 @@
+/**
+ * @author Ashwin K J
+ * @file
+ * Verify_Cache Class: Remembering the LLVM IR contents that have already passed verification
+ */
+#ifndef VERIFY_CACHE_H
+#define VERIFY_CACHE_H
+
+#include <iostream>
+#include <llvm/ADT/StringRef.h>
+#include <mutex>
+#include <set>
+#include <string>
+namespace hydrogen_framework {
+/**
+ * Verify_Cache Class: Set of content hashes of verified LLVM IR files, kept in a text file between runs
+ */
+class Verify_Cache {
+public:
+  /**
+   * Constructor
+   */
+  Verify_Cache(std::string file) : cacheFile(file) {}
+
+  /**
+   * Destructor
+   */
+  ~Verify_Cache() { cacheHashes.clear(); }
+
+  /**
+   * Read the hashes from cacheFile. A missing cacheFile is an empty cache
+   */
+  void loadCache();
+
+  /**
+   * Write the hashes to cacheFile
+   * Returns FALSE if cacheFile cannot be written
+   */
+  bool saveCache();
+
+  /**
+   * Return the content hash of the given LLVM IR contents
+   */
+  static std::string getContentHash(llvm::StringRef contents);
+
+  /**
+   * Return TRUE if contents with the given hash have already been verified
+   */
+  bool isVerified(std::string hash);
+
+  /**
+   * Record that contents with the given hash passed verification
+   */
+  void insertVerified(std::string hash);
+
+private:
+  std::string cacheFile;             /**< Path to the file holding the cache */
+  std::set<std::string> cacheHashes; /**< Container for content hashes of verified LLVM IR */
+  std::mutex cacheMutex;             /**< Guards cacheHashes when modules are loaded in the background */
+};                                   // End Verify_Cache Class
+} // namespace hydrogen_framework
+#endif